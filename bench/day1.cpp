@@ -0,0 +1,34 @@
+#include <string>
+#include <benchmark/benchmark.h>
+
+#include "aoc2023.hpp"
+#include "2023/day1.hpp"
+#include "microbench.hpp"
+
+// Throughput over a raw buffer, state.range(0) is the generator scale
+static auto BM_sum_calibration_values(benchmark::State& state) -> void {
+    std::string calibration_buffer{};
+    for (auto const& line : AoC2023::generate_day1(state.range(0), MICROBENCH_SEED)) {
+        calibration_buffer += line;
+        calibration_buffer += '\n';
+    }
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sum_calibration_values(calibration_buffer));
+    }
+
+    state.SetBytesProcessed(state.iterations() * calibration_buffer.size());
+}
+BENCHMARK(BM_sum_calibration_values)->RangeMultiplier(8)->Range(1, 512)->Apply(stable_statistics);
+
+static auto BM_day1_part1(benchmark::State& state) -> void {
+    auto const input = AoC2023::generate_day1(state.range(0), MICROBENCH_SEED);
+    auto const solution = (state.range(1) == 0) ? &AoC2023::day1_part1 : &AoC2023::day1_part1_simd;
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(solution(input));
+    }
+
+    state.SetBytesProcessed(state.iterations() * bench_input_bytes(input));
+}
+BENCHMARK(BM_day1_part1)->ArgsProduct({ { 1, 64 }, { 0, 1 } })->Apply(stable_statistics);
@@ -0,0 +1,39 @@
+#include <array>
+#include <benchmark/benchmark.h>
+
+#include "aoc2023.hpp"
+#include "2023/day10.hpp"
+#include "microbench.hpp"
+
+// state.range(0) is the generator scale, the loop grows with its square root
+static auto BM_find_loop(benchmark::State& state) -> void {
+    auto [animal_position, pipe_map] = parse_pipe_map(AoC2023::generate_day10(state.range(0), MICROBENCH_SEED));
+    fill_missing_pipe(animal_position, pipe_map);
+    std::size_t loop_length = 0;
+
+    for (auto _ : state) {
+        auto const loop_directions = find_loop(animal_position, pipe_map);
+        loop_length = loop_directions.size();
+        benchmark::DoNotOptimize(loop_directions.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * loop_length);
+}
+BENCHMARK(BM_find_loop)->RangeMultiplier(4)->Range(1, 64)->Apply(stable_statistics);
+
+static auto BM_can_connect(benchmark::State& state) -> void {
+    static constexpr std::array DIRECTIONS {
+        None, North, East, NorthEast, South, NorthSouth, SouthEast, West, NorthWest, EastWest, SouthWest
+    };
+
+    for (auto _ : state) {
+        for (auto const ours : DIRECTIONS) {
+            for (auto const theirs : DIRECTIONS) {
+                benchmark::DoNotOptimize(can_connect(ours, theirs));
+            }
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * DIRECTIONS.size() * DIRECTIONS.size());
+}
+BENCHMARK(BM_can_connect)->Apply(stable_statistics);
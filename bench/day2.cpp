@@ -0,0 +1,66 @@
+#include <cstddef>
+#include <random>
+#include <vector>
+#include <benchmark/benchmark.h>
+
+#include "aoc2023.hpp"
+#include "2023/day2.hpp"
+#include "microbench.hpp"
+
+static auto random_bags(std::size_t count) -> std::vector<GameBag> {
+    std::mt19937_64 engine(MICROBENCH_SEED);
+    std::uniform_int_distribution<int> cubes(1, 20);
+
+    std::vector<GameBag> bags(count);
+    for (auto& bag : bags) {
+        bag = { cubes(engine), cubes(engine), cubes(engine) };
+    }
+
+    return bags;
+}
+
+// 4096 bag queries against the game log of generator scale state.range(0),
+// answered by scanning the columns once per bag
+static auto BM_day2_bags_scan(benchmark::State& state) -> void {
+    auto const columns = parse_game_columns(AoC2023::generate_day2(state.range(0), MICROBENCH_SEED));
+    auto const bags = random_bags(4096);
+
+    for (auto _ : state) {
+        for (auto const bag : bags) {
+            SolutionReturn acc = 0;
+            for (std::size_t i = 0; i < columns.id.size(); ++i) {
+                bool const valid_game = (columns.red[i] <= bag.red) & (columns.green[i] <= bag.green) & (columns.blue[i] <= bag.blue);
+                acc += columns.id[i] * static_cast<int>(valid_game);
+            }
+
+            benchmark::DoNotOptimize(acc);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * bags.size());
+}
+BENCHMARK(BM_day2_bags_scan)->RangeMultiplier(8)->Range(1, 64)->Apply(stable_statistics);
+
+static auto BM_GameLimitIndex_feasible_id_sums(benchmark::State& state) -> void {
+    GameLimitIndex const index{ parse_game_columns(AoC2023::generate_day2(state.range(0), MICROBENCH_SEED)) };
+    auto const bags = random_bags(4096);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(index.feasible_id_sums(bags));
+    }
+
+    state.SetItemsProcessed(state.iterations() * bags.size());
+}
+BENCHMARK(BM_GameLimitIndex_feasible_id_sums)->RangeMultiplier(8)->Range(1, 64)->Apply(stable_statistics);
+
+static auto BM_GameLimitIndex_build(benchmark::State& state) -> void {
+    auto const columns = parse_game_columns(AoC2023::generate_day2(state.range(0), MICROBENCH_SEED));
+
+    for (auto _ : state) {
+        GameLimitIndex index{ columns };
+        benchmark::DoNotOptimize(index);
+    }
+
+    state.SetItemsProcessed(state.iterations() * columns.id.size());
+}
+BENCHMARK(BM_GameLimitIndex_build)->RangeMultiplier(8)->Range(1, 64)->Apply(stable_statistics);
@@ -0,0 +1,66 @@
+#include <benchmark/benchmark.h>
+
+#include "aoc2023.hpp"
+#include "2023/day3.hpp"
+#include "microbench.hpp"
+
+// Mask and sum passes over an already loaded grid, state.range(0) is the
+// generator scale
+static auto BM_sum_part_numbers(benchmark::State& state) -> void {
+    auto const grid = SchematicGrid::from_lines(AoC2023::generate_day3(state.range(0), MICROBENCH_SEED));
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sum_part_numbers(grid));
+    }
+
+    state.SetBytesProcessed(state.iterations() * grid.cells.size());
+}
+BENCHMARK(BM_sum_part_numbers)->RangeMultiplier(8)->Range(1, 512)->Apply(stable_statistics);
+
+static auto BM_day3_part1(benchmark::State& state) -> void {
+    auto const input = AoC2023::generate_day3(state.range(0), MICROBENCH_SEED);
+    auto const solution = (state.range(1) == 0) ? &AoC2023::day3_part1 : &AoC2023::day3_part1_grid;
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(solution(input));
+    }
+
+    state.SetBytesProcessed(state.iterations() * bench_input_bytes(input));
+}
+BENCHMARK(BM_day3_part1)->ArgsProduct({ { 1, 64 }, { 0, 1 } })->Apply(stable_statistics);
+
+// Labeling pass plus the gear lookups of both parts
+static auto BM_sum_schematic(benchmark::State& state) -> void {
+    auto const grid = SchematicGrid::from_lines(AoC2023::generate_day3(state.range(0), MICROBENCH_SEED));
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sum_schematic(grid));
+    }
+
+    state.SetBytesProcessed(state.iterations() * grid.cells.size());
+}
+BENCHMARK(BM_sum_schematic)->RangeMultiplier(8)->Range(1, 512)->Apply(stable_statistics);
+
+static auto BM_day3_part2(benchmark::State& state) -> void {
+    auto const input = AoC2023::generate_day3(state.range(0), MICROBENCH_SEED);
+    auto const solution = (state.range(1) == 0) ? &AoC2023::day3_part2 : &AoC2023::day3_part2_labels;
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(solution(input));
+    }
+
+    state.SetBytesProcessed(state.iterations() * bench_input_bytes(input));
+}
+BENCHMARK(BM_day3_part2)->ArgsProduct({ { 1, 64 }, { 0, 1 } })->Apply(stable_statistics);
+
+// Tiles of a large schematic on state.range(0) threads
+static auto BM_sum_schematic_tiled(benchmark::State& state) -> void {
+    auto const input = AoC2023::generate_day3(512, MICROBENCH_SEED);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sum_schematic_tiled(input, state.range(0)));
+    }
+
+    state.SetBytesProcessed(state.iterations() * bench_input_bytes(input));
+}
+BENCHMARK(BM_sum_schematic_tiled)->RangeMultiplier(2)->Range(1, 16)->UseRealTime()->Apply(stable_statistics);
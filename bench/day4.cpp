@@ -0,0 +1,38 @@
+#include <random>
+#include <vector>
+#include <benchmark/benchmark.h>
+
+#include "aoc2023.hpp"
+#include "2023/day4.hpp"
+#include "microbench.hpp"
+
+// state.range(0) cards with 0 or 1 matches each, more than one on average
+// grows the copy counts past 64 bits within a few hundred cards
+static auto BM_count_scratch_cards(benchmark::State& state) -> void {
+    std::mt19937_64 engine(MICROBENCH_SEED);
+    std::uniform_int_distribution<int> matches(0, 1);
+
+    std::vector<int> card_matches(state.range(0));
+    for (auto& card : card_matches) {
+        card = matches(engine);
+    }
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(count_scratch_cards(card_matches));
+    }
+
+    state.SetItemsProcessed(state.iterations() * card_matches.size());
+}
+BENCHMARK(BM_count_scratch_cards)->RangeMultiplier(32)->Range(1 << 10, 1 << 20)->Apply(stable_statistics);
+
+static auto BM_day4_part2(benchmark::State& state) -> void {
+    auto const input = AoC2023::generate_day4(state.range(0), MICROBENCH_SEED);
+    auto const solution = (state.range(1) == 0) ? &AoC2023::day4_part2 : &AoC2023::day4_part2_bitset;
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(solution(input));
+    }
+
+    state.SetBytesProcessed(state.iterations() * bench_input_bytes(input));
+}
+BENCHMARK(BM_day4_part2)->ArgsProduct({ { 1, 64 }, { 0, 1 } })->Apply(stable_statistics);
@@ -0,0 +1,189 @@
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <list>
+#include <random>
+#include <vector>
+#include <benchmark/benchmark.h>
+
+#include "aoc2023.hpp"
+#include "2023/day5.hpp"
+#include "microbench.hpp"
+
+static auto BM_AlmanacRange_slices(benchmark::State& state) -> void {
+    std::mt19937_64 engine(MICROBENCH_SEED);
+    std::uniform_int_distribution<std::int64_t> start(0, 1'000'000);
+    std::uniform_int_distribution<std::int64_t> length(1, 500'000);
+
+    std::vector<std::pair<AlmanacRange, AlmanacRange>> ranges(4096);
+    for (auto& [lhs, rhs] : ranges) {
+        lhs = { start(engine), length(engine), 0 };
+        rhs = { start(engine), length(engine), 0 };
+    }
+
+    std::size_t i = 0;
+    for (auto _ : state) {
+        auto const& [lhs, rhs] = ranges[i++ % ranges.size()];
+        benchmark::DoNotOptimize(AlmanacRange::slices(lhs, rhs));
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_AlmanacRange_slices)->Apply(stable_statistics);
+
+// Pushes the seed ranges of a generated almanac through every row of its
+// first section, state.range(0) is the generator scale
+static auto BM_check_range_bound_and_update_almanac(benchmark::State& state) -> void {
+    auto const input = AoC2023::generate_day5(state.range(0), MICROBENCH_SEED);
+    auto const seeds = parse_almanac_table(SolutionInputValue{ input.front() }, IDChunkType::Pair);
+
+    std::vector<SourceDestinationRange> rows{};
+    for (auto line = input.begin() + 3; line != input.end() && !line->empty(); ++line) {
+        auto const numbers = parse_numbers(*line);
+        rows.push_back({ numbers.at(0), numbers.at(1), numbers.at(2) });
+    }
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto almanac = seeds;
+        state.ResumeTiming();
+
+        for (auto const& row : rows) {
+            check_range_bound_and_update_almanac(row, almanac, 0);
+        }
+
+        benchmark::DoNotOptimize(almanac.size());
+    }
+
+    state.SetItemsProcessed(state.iterations() * rows.size());
+}
+BENCHMARK(BM_check_range_bound_and_update_almanac)->RangeMultiplier(4)->Range(1, 16)->Apply(stable_statistics);
+
+// Parsing the sections and composing them, state.range(0) is the generator
+// scale
+static auto BM_CompiledAlmanac_parse(benchmark::State& state) -> void {
+    auto const input = AoC2023::generate_day5(state.range(0), MICROBENCH_SEED);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(CompiledAlmanac::parse(input, IDChunkType::Pair));
+    }
+
+    state.SetBytesProcessed(state.iterations() * bench_input_bytes(input));
+}
+BENCHMARK(BM_CompiledAlmanac_parse)->RangeMultiplier(4)->Range(1, 64)->Apply(stable_statistics);
+
+static auto BM_day5_part2(benchmark::State& state) -> void {
+    auto const input = AoC2023::generate_day5(state.range(0), MICROBENCH_SEED);
+    static constexpr std::array SOLUTIONS { &AoC2023::day5_part2, &AoC2023::day5_part2_composed, &AoC2023::day5_part2_reverse };
+    auto const solution = SOLUTIONS.at(state.range(1));
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(solution(input));
+    }
+
+    state.SetBytesProcessed(state.iterations() * bench_input_bytes(input));
+}
+BENCHMARK(BM_day5_part2)->ArgsProduct({ { 1, 4 }, { 0, 1, 2 } })->Apply(stable_statistics);
+
+static auto random_seeds(std::size_t count) -> std::vector<std::int64_t> {
+    std::mt19937_64 engine(MICROBENCH_SEED);
+    std::uniform_int_distribution<std::int64_t> id(0, (std::int64_t{1} << 32) - 1);
+
+    std::vector<std::int64_t> seeds(count);
+    for (auto& seed : seeds) {
+        seed = id(engine);
+    }
+
+    return seeds;
+}
+
+// 1M seeds through the composed map of a generated almanac, state.range(0) is
+// the generator scale
+static auto BM_AlmanacMap_point_queries(benchmark::State& state) -> void {
+    auto const almanac = CompiledAlmanac::parse(AoC2023::generate_day5(state.range(0), MICROBENCH_SEED), IDChunkType::Pair);
+    auto const seeds = random_seeds(1 << 20);
+    std::vector<std::int64_t> locations(seeds.size());
+
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < seeds.size(); ++i) {
+            locations[i] = almanac.seed_to_location(seeds[i]);
+        }
+        benchmark::DoNotOptimize(locations.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * seeds.size());
+}
+BENCHMARK(BM_AlmanacMap_point_queries)->RangeMultiplier(8)->Range(1, 64)->Apply(stable_statistics);
+
+static auto BM_AlmanacLookup_translate(benchmark::State& state) -> void {
+    auto const almanac = CompiledAlmanac::parse(AoC2023::generate_day5(state.range(0), MICROBENCH_SEED), IDChunkType::Pair);
+    auto const lookup = AlmanacLookup::from_map(almanac.seed_to_location);
+    auto const seeds = random_seeds(1 << 20);
+    std::vector<std::int64_t> locations(seeds.size());
+
+    for (auto _ : state) {
+        lookup.translate(seeds, locations);
+        benchmark::DoNotOptimize(locations.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * seeds.size());
+}
+BENCHMARK(BM_AlmanacLookup_translate)->RangeMultiplier(8)->Range(1, 64)->Apply(stable_statistics);
+
+// Smallest location of state.range(0) random seed ranges in a scale 64
+// almanac, mapping every range forwards against walking locations upwards
+static auto random_seed_ranges(std::size_t count) -> std::vector<AlmanacRange> {
+    std::mt19937_64 engine(MICROBENCH_SEED);
+    std::uniform_int_distribution<std::int64_t> start(0, (std::int64_t{1} << 32) - 1);
+    std::uniform_int_distribution<std::int64_t> length(1, 10'000);
+
+    std::vector<AlmanacRange> ranges(count);
+    for (auto& range : ranges) {
+        range = { start(engine), length(engine), 0 };
+    }
+
+    return merge_almanac_ranges(ranges);
+}
+
+static auto BM_AlmanacMap_min_image(benchmark::State& state) -> void {
+    auto const almanac = CompiledAlmanac::parse(AoC2023::generate_day5(64, MICROBENCH_SEED), IDChunkType::Pair);
+    auto const ranges = random_seed_ranges(state.range(0));
+
+    for (auto _ : state) {
+        std::int64_t location = std::numeric_limits<std::int64_t>::max();
+        for (auto const& range : ranges) {
+            location = std::min(location, almanac.seed_to_location.min_image(range));
+        }
+        benchmark::DoNotOptimize(location);
+    }
+
+    state.SetItemsProcessed(state.iterations() * ranges.size());
+}
+BENCHMARK(BM_AlmanacMap_min_image)->RangeMultiplier(16)->Range(16, 1 << 16)->Apply(stable_statistics);
+
+static auto BM_AlmanacPreimages_min_image(benchmark::State& state) -> void {
+    auto const almanac = CompiledAlmanac::parse(AoC2023::generate_day5(64, MICROBENCH_SEED), IDChunkType::Pair);
+    auto const preimages = AlmanacPreimages::from_map(almanac.seed_to_location);
+    auto const ranges = random_seed_ranges(state.range(0));
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(preimages.min_image(ranges));
+    }
+
+    state.SetItemsProcessed(state.iterations() * ranges.size());
+}
+BENCHMARK(BM_AlmanacPreimages_min_image)->RangeMultiplier(16)->Range(16, 1 << 16)->Apply(stable_statistics);
+
+// 64K random seed ranges split through the sections on state.range(0) threads
+static auto BM_CompiledAlmanac_min_location_parallel(benchmark::State& state) -> void {
+    auto almanac = CompiledAlmanac::parse(AoC2023::generate_day5(64, MICROBENCH_SEED), IDChunkType::Pair);
+    almanac.seeds = random_seed_ranges(1 << 16);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(almanac.min_location_parallel(state.range(0)));
+    }
+
+    state.SetItemsProcessed(state.iterations() * almanac.seeds.size());
+}
+BENCHMARK(BM_CompiledAlmanac_min_location_parallel)->RangeMultiplier(2)->Range(1, 16)->UseRealTime()->Apply(stable_statistics);
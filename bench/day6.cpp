@@ -0,0 +1,67 @@
+#include <cstdint>
+#include <random>
+#include <vector>
+#include <benchmark/benchmark.h>
+
+#include "aoc2023.hpp"
+#include "2023/day6.hpp"
+#include "microbench.hpp"
+
+// state.range(0) races with times up to 2^32 and records somewhere below the
+// best distance of their race
+static auto random_races(std::size_t count) -> std::vector<RaceRecord> {
+    std::mt19937_64 engine(MICROBENCH_SEED);
+    std::uniform_int_distribution<std::int64_t> time(1, std::int64_t{1} << 32);
+    std::uniform_real_distribution<double> record(0.0, 1.0);
+
+    std::vector<RaceRecord> races(count);
+    for (auto& race : races) {
+        race.time = time(engine);
+        race.record = static_cast<std::int64_t>(record(engine) * static_cast<double>(race.time / 2) * static_cast<double>(race.time / 2));
+    }
+
+    return races;
+}
+
+static auto BM_count_winning_holds(benchmark::State& state) -> void {
+    auto const races = random_races(state.range(0));
+
+    for (auto _ : state) {
+        std::int64_t total = 0;
+        for (auto const& race : races) {
+            total += count_winning_holds(race);
+        }
+        benchmark::DoNotOptimize(total);
+    }
+
+    state.SetItemsProcessed(state.iterations() * races.size());
+}
+BENCHMARK(BM_count_winning_holds)->RangeMultiplier(32)->Range(1 << 10, 1 << 20)->Apply(stable_statistics);
+
+static auto BM_count_winning_holds_batch(benchmark::State& state) -> void {
+    auto const races = random_races(state.range(0));
+    std::vector<std::int64_t> counts(races.size());
+
+    for (auto _ : state) {
+        count_winning_holds(races, counts);
+        benchmark::DoNotOptimize(counts.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * races.size());
+}
+BENCHMARK(BM_count_winning_holds_batch)->RangeMultiplier(32)->Range(1 << 10, 1 << 20)->Apply(stable_statistics);
+
+// state.range(0) is the generator scale, which sets the number of digits of
+// the race
+static auto BM_day6_part2(benchmark::State& state) -> void {
+    auto const input = AoC2023::generate_day6_part2(state.range(0), MICROBENCH_SEED);
+    auto const solution = (state.range(1) == 0) ? &AoC2023::day6_part2 : &AoC2023::day6_part2_closed_form;
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(solution(input));
+    }
+
+    state.SetBytesProcessed(state.iterations() * bench_input_bytes(input));
+}
+BENCHMARK(BM_day6_part2)->ArgsProduct({ { 1, 128 }, { 0, 1 } })->Apply(stable_statistics);
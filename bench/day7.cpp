@@ -0,0 +1,125 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <span>
+#include <vector>
+#include <benchmark/benchmark.h>
+
+#include "aoc2023.hpp"
+#include "2023/day7.hpp"
+#include "microbench.hpp"
+
+template<JokerRule Rule>
+static auto BM_Hand_compute_hand(benchmark::State& state) -> void {
+    auto const hands = parse_game_hands<Rule>(AoC2023::generate_day7(1, MICROBENCH_SEED));
+
+    std::size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Hand<Rule>::compute_hand(hands[i++ % hands.size()]));
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Hand_compute_hand<JokerRule::Disabled>)->Apply(stable_statistics);
+BENCHMARK(BM_Hand_compute_hand<JokerRule::Enabled>)->Apply(stable_statistics);
+
+template<JokerRule Rule>
+static auto BM_Hand_less(benchmark::State& state) -> void {
+    auto const hands = parse_game_hands<Rule>(AoC2023::generate_day7(1, MICROBENCH_SEED));
+
+    std::size_t i = 0;
+    for (auto _ : state) {
+        auto const& lhs = hands[i % hands.size()];
+        auto const& rhs = hands[(i + 1) % hands.size()];
+        benchmark::DoNotOptimize(lhs < rhs);
+        ++i;
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Hand_less<JokerRule::Disabled>)->Apply(stable_statistics);
+BENCHMARK(BM_Hand_less<JokerRule::Enabled>)->Apply(stable_statistics);
+
+// state.range(0) random hands ranked by key, state.range(1) picks std::sort
+// or the radix sort
+static auto BM_rank_hands(benchmark::State& state) -> void {
+    std::mt19937_64 engine(MICROBENCH_SEED);
+    std::uniform_int_distribution<int> rank(0, 12);
+    std::uniform_int_distribution<int> bid(1, 1000);
+
+    std::vector<HandBid> hands(state.range(0));
+    for (auto& hand : hands) {
+        HandCards cards{ {}, bid(engine) };
+        for (auto& card : cards.ranks) {
+            card = static_cast<std::uint8_t>(rank(engine));
+        }
+        hand = { hand_key<JokerRule::Disabled>(cards), cards.bid };
+    }
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto ranked = hands;
+        state.ResumeTiming();
+
+        if (state.range(1) == 0) {
+            std::ranges::stable_sort(ranked, {}, &HandBid::key);
+        } else {
+            rank_hands(ranked);
+        }
+        benchmark::DoNotOptimize(ranked.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * hands.size());
+}
+BENCHMARK(BM_rank_hands)->ArgsProduct({ { 1 << 10, 1 << 15, 1 << 20 }, { 0, 1 } })->Apply(stable_statistics);
+
+static auto BM_day7_part1(benchmark::State& state) -> void {
+    auto const input = AoC2023::generate_day7(state.range(0), MICROBENCH_SEED);
+    auto const solution = (state.range(1) == 0) ? &AoC2023::day7_part1 : &AoC2023::day7_part1_radix;
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(solution(input));
+    }
+
+    state.SetBytesProcessed(state.iterations() * bench_input_bytes(input));
+}
+BENCHMARK(BM_day7_part1)->ArgsProduct({ { 1, 16 }, { 0, 1 } })->Apply(stable_statistics);
+
+// Both parts from one parse on state.range(0) threads
+static auto BM_camel_cards_winnings(benchmark::State& state) -> void {
+    auto const input = AoC2023::generate_day7(256, MICROBENCH_SEED);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(camel_cards_winnings(input, state.range(0)));
+    }
+
+    state.SetBytesProcessed(state.iterations() * bench_input_bytes(input));
+}
+BENCHMARK(BM_camel_cards_winnings)->DenseRange(1, 2)->UseRealTime()->Apply(stable_statistics);
+
+// 64K hands arriving in batches of state.range(0), with the winnings needed
+// after every batch. state.range(1) picks a full re-rank of every hand so far
+// or the leaderboard.
+static auto BM_HandLeaderboard_stream(benchmark::State& state) -> void {
+    auto const hands = parse_hand_cards(AoC2023::generate_day7(64, MICROBENCH_SEED));
+    std::span<HandCards const> const stream{ hands };
+    auto const batch = static_cast<std::size_t>(state.range(0));
+
+    for (auto _ : state) {
+        HandLeaderboard<JokerRule::Disabled> leaderboard{};
+        for (std::size_t done = 0; done < stream.size(); done += batch) {
+            auto const next = stream.subspan(done, std::min(batch, stream.size() - done));
+            if (state.range(1) == 0) {
+                auto ranked = key_hands<JokerRule::Disabled>(stream.first(done + next.size()));
+                rank_hands(ranked);
+                benchmark::DoNotOptimize(total_winnings(ranked));
+            } else {
+                benchmark::DoNotOptimize(leaderboard.insert(next));
+            }
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * hands.size());
+}
+BENCHMARK(BM_HandLeaderboard_stream)->ArgsProduct({ { 64, 1024 }, { 0, 1 } })->Apply(stable_statistics);
@@ -0,0 +1,135 @@
+#include <cstdint>
+#include <string>
+#include <benchmark/benchmark.h>
+
+#include "aoc2023.hpp"
+#include "2023/day8.hpp"
+#include "microbench.hpp"
+
+// One step along the instructions from AAA, state.range(0) is the generator scale
+static auto BM_Network_next(benchmark::State& state) -> void {
+    auto const network = Network::parse_network(AoC2023::generate_day8(state.range(0), MICROBENCH_SEED));
+    auto walker = network.walker("AAA");
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(network.next(walker).data());
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Network_next)->RangeMultiplier(8)->Range(1, 64)->Apply(stable_statistics);
+
+static auto BM_InternedNetwork_next(benchmark::State& state) -> void {
+    auto const network = InternedNetwork::parse(AoC2023::generate_day8(state.range(0), MICROBENCH_SEED));
+    auto node = *network.id("AAA");
+    std::size_t step = 0;
+
+    for (auto _ : state) {
+        node = network.next(node, step);
+        step = (step + 1 == network.turn_count) ? 0 : step + 1;
+        benchmark::DoNotOptimize(node);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_InternedNetwork_next)->RangeMultiplier(8)->Range(1, 64)->Apply(stable_statistics);
+
+static auto BM_day8_part1(benchmark::State& state) -> void {
+    auto const input = AoC2023::generate_day8(state.range(0), MICROBENCH_SEED);
+    auto const solution = (state.range(1) == 0) ? &AoC2023::day8_part1 : &AoC2023::day8_part1_interned;
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(solution(input));
+    }
+
+    state.SetBytesProcessed(state.iterations() * bench_input_bytes(input));
+}
+BENCHMARK(BM_day8_part1)->ArgsProduct({ { 1, 64 }, { 0, 1 } })->Apply(stable_statistics);
+
+// Where AAA is after state.range(0) steps of a scale 64 network, walked one
+// step at a time
+static auto BM_InternedNetwork_walk(benchmark::State& state) -> void {
+    auto const network = InternedNetwork::parse(AoC2023::generate_day8(64, MICROBENCH_SEED));
+    auto const start = *network.id("AAA");
+    auto const steps = static_cast<std::uint64_t>(state.range(0));
+
+    for (auto _ : state) {
+        auto node = start;
+        for (std::uint64_t step = 0; step < steps; ++step) {
+            node = network.next(node, step % network.turn_count);
+        }
+        benchmark::DoNotOptimize(node);
+    }
+}
+BENCHMARK(BM_InternedNetwork_walk)->RangeMultiplier(64)->Range(1 << 10, 1 << 22)->Apply(stable_statistics);
+
+// The same walks answered from the jump tables
+static auto BM_PassJumps_position(benchmark::State& state) -> void {
+    PassJumps const jumps{ InternedNetwork::parse(AoC2023::generate_day8(64, MICROBENCH_SEED)) };
+    auto const start = *jumps.network().id("AAA");
+    auto const steps = static_cast<std::uint64_t>(state.range(0));
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(jumps.position(start, steps));
+    }
+}
+BENCHMARK(BM_PassJumps_position)->RangeMultiplier(64)->Range(1 << 10, 1 << 22)->Apply(stable_statistics);
+
+// Building the jump tables of a network at generator scale state.range(0)
+static auto BM_PassJumps_build(benchmark::State& state) -> void {
+    auto const network = InternedNetwork::parse(AoC2023::generate_day8(state.range(0), MICROBENCH_SEED));
+
+    for (auto _ : state) {
+        PassJumps jumps{ network };
+        benchmark::DoNotOptimize(jumps);
+    }
+}
+BENCHMARK(BM_PassJumps_build)->RangeMultiplier(8)->Range(1, 64)->Apply(stable_statistics);
+
+// First Z hit from every node with the memo filled as the queries go
+static auto BM_PassJumps_first_z(benchmark::State& state) -> void {
+    auto const network = InternedNetwork::parse(AoC2023::generate_day8(state.range(0), MICROBENCH_SEED));
+
+    for (auto _ : state) {
+        PassJumps jumps{ network };
+        for (std::size_t node = 0; node < network.node_count(); ++node) {
+            benchmark::DoNotOptimize(jumps.first_z(static_cast<PassJumps::node_id_type>(node)));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(network.node_count()));
+}
+BENCHMARK(BM_PassJumps_first_z)->RangeMultiplier(8)->Range(1, 64)->Apply(stable_statistics);
+
+// Every ghost of a scale 64 reference network walked to its first Z node on
+// state.range(0) threads, one thread is the serial walk
+static auto BM_ghost_steps_to_z(benchmark::State& state) -> void {
+    auto const network = Network::parse_network(AoC2023::generate_day8(64, MICROBENCH_SEED));
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ghost_steps_to_z(network, static_cast<std::size_t>(state.range(0))));
+    }
+}
+BENCHMARK(BM_ghost_steps_to_z)->RangeMultiplier(2)->Range(1, 8)->UseRealTime()->Apply(stable_statistics);
+
+// Every ghost of a scale 64 network walked to its cycle on state.range(0) threads
+static auto BM_analyse_ghosts(benchmark::State& state) -> void {
+    auto const network = InternedNetwork::parse(AoC2023::generate_day8(64, MICROBENCH_SEED));
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(analyse_ghosts(network, static_cast<std::size_t>(state.range(0))));
+    }
+}
+BENCHMARK(BM_analyse_ghosts)->RangeMultiplier(2)->Range(1, 8)->UseRealTime()->Apply(stable_statistics);
+
+static auto BM_day8_part2(benchmark::State& state) -> void {
+    auto const input = AoC2023::generate_day8(state.range(0), MICROBENCH_SEED);
+    auto const solution = (state.range(1) == 0) ? &AoC2023::day8_part2 : &AoC2023::day8_part2_cycles;
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(solution(input));
+    }
+
+    state.SetBytesProcessed(state.iterations() * bench_input_bytes(input));
+}
+BENCHMARK(BM_day8_part2)->ArgsProduct({ { 1, 64 }, { 0, 1 } })->Apply(stable_statistics);
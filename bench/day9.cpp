@@ -0,0 +1,24 @@
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <benchmark/benchmark.h>
+
+#include "aoc2023.hpp"
+#include "2023/day9.hpp"
+#include "microbench.hpp"
+
+static auto BM_PolynomialSequence(benchmark::State& state) -> void {
+    std::vector<std::vector<std::int64_t>> reports{};
+    for (auto const& line : AoC2023::generate_day9(1, MICROBENCH_SEED)) {
+        reports.push_back(parse_numbers(line));
+    }
+
+    std::size_t i = 0;
+    for (auto _ : state) {
+        PolynomialSequence sequence{ reports[i++ % reports.size()], 0 };
+        benchmark::DoNotOptimize(sequence.next.get());
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_PolynomialSequence)->Apply(stable_statistics);
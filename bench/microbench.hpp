@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <string_view>
+#include <vector>
+#include <benchmark/benchmark.h>
+
+#include "solution.hpp"
+
+static constexpr std::uint64_t MICROBENCH_SEED = 2023;
+
+// Repeated runs reported as mean/median/stddev, so that kernel rewrites can be
+// compared against run-to-run noise
+inline auto stable_statistics(benchmark::internal::Benchmark* benchmark) -> void {
+    benchmark->Repetitions(10)->ReportAggregatesOnly(true);
+}
+
+inline auto bench_input_bytes(SolutionInput input) -> std::size_t {
+    std::size_t bytes = 0;
+    for (auto const& line : input) {
+        bytes += line.size() + 1;
+    }
+
+    return bytes;
+}
+
+inline auto parse_numbers(std::string_view line) -> std::vector<std::int64_t> {
+    std::vector<std::int64_t> numbers{};
+    std::istringstream stream{ std::string{line} };
+    for (std::int64_t n; stream >> n;) {
+        numbers.push_back(n);
+    }
+
+    return numbers;
+}
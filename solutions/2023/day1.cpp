@@ -1,5 +1,8 @@
 #include <algorithm>
+#include <bit>
 #include <cctype>
+#include <cstdint>
+#include <stdexcept>
 #include <tuple>
 #include <numeric>
 #include <string>
@@ -9,8 +12,13 @@
 #include <ranges>
 #include <fmt/core.h>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 #include "aoc2023.hpp"
 #include "solution.hpp"
+#include "day1.hpp"
 
 auto AoC2023::day1_part1(SolutionInput input) -> SolutionReturn {
     std::vector<int> numbers{};
@@ -42,6 +50,156 @@ auto AoC2023::day1_part1(SolutionInput input) -> SolutionReturn {
     return std::accumulate(digits.begin(), digits.end(), 0);
 }
 
+static constexpr std::size_t BLOCK_SIZE = 16;
+
+// Bit i is set when byte i of the block is an ASCII digit
+static auto digit_mask(char const* block) -> std::uint32_t {
+#if defined(__SSE2__)
+    auto const bytes = _mm_loadu_si128(reinterpret_cast<__m128i const*>(block));
+    auto const offsets = _mm_sub_epi8(bytes, _mm_set1_epi8('0'));
+    auto const digits = _mm_cmpeq_epi8(_mm_min_epu8(offsets, _mm_set1_epi8(9)), offsets);
+    return static_cast<std::uint32_t>(_mm_movemask_epi8(digits));
+#else
+    std::uint32_t mask = 0;
+    for (std::size_t i = 0; i < BLOCK_SIZE; ++i) {
+        mask |= static_cast<std::uint32_t>(block[i] >= '0' && block[i] <= '9') << i;
+    }
+    return mask;
+#endif
+}
+
+// Bit i is set when byte i of the block is a newline
+static auto newline_mask(char const* block) -> std::uint32_t {
+#if defined(__SSE2__)
+    auto const bytes = _mm_loadu_si128(reinterpret_cast<__m128i const*>(block));
+    return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8('\n'))));
+#else
+    std::uint32_t mask = 0;
+    for (std::size_t i = 0; i < BLOCK_SIZE; ++i) {
+        mask |= static_cast<std::uint32_t>(block[i] == '\n') << i;
+    }
+    return mask;
+#endif
+}
+
+static auto first_digit(std::string_view line) -> int {
+    std::size_t i = 0;
+    for (; i + BLOCK_SIZE <= line.size(); i += BLOCK_SIZE) {
+        if (auto const mask = digit_mask(line.data() + i); mask != 0) {
+            return line[i + std::countr_zero(mask)] - '0';
+        }
+    }
+
+    for (; i < line.size(); ++i) {
+        if (std::isdigit(line[i])) {
+            return line[i] - '0';
+        }
+    }
+
+    return -1;
+}
+
+static auto last_digit(std::string_view line) -> int {
+    std::size_t i = line.size();
+    for (; i >= BLOCK_SIZE; i -= BLOCK_SIZE) {
+        if (auto const mask = digit_mask(line.data() + i - BLOCK_SIZE); mask != 0) {
+            return line[i - BLOCK_SIZE + (31 - std::countl_zero(mask))] - '0';
+        }
+    }
+
+    for (; i > 0; --i) {
+        if (std::isdigit(line[i - 1])) {
+            return line[i - 1] - '0';
+        }
+    }
+
+    return -1;
+}
+
+auto sum_calibration_values(std::string_view calibration_buffer) -> SolutionReturn {
+    SolutionReturn acc = 0;
+    int first_value = -1;
+    int last_value = -1;
+
+    auto const close_line = [&]() {
+        if (first_value < 0) {
+            throw std::out_of_range("calibration line without any digit");
+        }
+
+        acc += (first_value * 10) + last_value;
+        first_value = -1;
+        last_value = -1;
+    };
+
+    // Splits every block at its newlines, the digits between two newlines
+    // only contribute their lowest and highest set bit
+    auto const scan_block = [&](char const* block, std::uint32_t digits, std::uint32_t newlines) {
+        while (true) {
+            auto const line_end = (newlines != 0) ? std::countr_zero(newlines) : 32;
+            auto const line_digits = (line_end < 32) ? digits & ((1u << line_end) - 1) : digits;
+
+            if (line_digits != 0) {
+                first_value = (first_value < 0) ? block[std::countr_zero(line_digits)] - '0' : first_value;
+                last_value = block[31 - std::countl_zero(line_digits)] - '0';
+            }
+
+            if (newlines == 0) {
+                break;
+            }
+
+            close_line();
+            digits &= ~line_digits;
+            newlines &= newlines - 1;
+        }
+    };
+
+    std::size_t i = 0;
+    for (; i + BLOCK_SIZE <= calibration_buffer.size(); i += BLOCK_SIZE) {
+        char const* block = calibration_buffer.data() + i;
+        scan_block(block, digit_mask(block), newline_mask(block));
+    }
+
+    for (; i < calibration_buffer.size(); ++i) {
+        if (calibration_buffer[i] == '\n') {
+            close_line();
+        } else if (std::isdigit(calibration_buffer[i])) {
+            first_value = (first_value < 0) ? calibration_buffer[i] - '0' : first_value;
+            last_value = calibration_buffer[i] - '0';
+        }
+    }
+
+    // A trailing newline ends the last line rather than starting another
+    if (!calibration_buffer.empty() && calibration_buffer.back() != '\n') {
+        close_line();
+    }
+
+    return acc;
+}
+
+auto AoC2023::day1_part1_buffer(SolutionInput input) -> SolutionReturn {
+    std::string calibration_buffer{};
+    for (auto const& calibration_line : input) {
+        calibration_buffer += calibration_line;
+        calibration_buffer += '\n';
+    }
+
+    return sum_calibration_values(calibration_buffer);
+}
+
+auto AoC2023::day1_part1_simd(SolutionInput input) -> SolutionReturn {
+    SolutionReturn acc = 0;
+    for (auto const& calibration_line : input) {
+        auto const first_value = first_digit(calibration_line);
+        if (first_value < 0) {
+            throw std::out_of_range("calibration line without any digit");
+        }
+
+        acc += (first_value * 10) + last_digit(calibration_line);
+    }
+
+    return acc;
+}
+
 auto AoC2023::day1_part2(SolutionInput input) -> SolutionReturn {
     static std::array<std::tuple<std::string_view, std::string_view>, 10> number_dictionary {
         std::tuple{"0", "zero"},
@@ -87,3 +245,106 @@ auto AoC2023::day1_part2(SolutionInput input) -> SolutionReturn {
 
     return std::accumulate(digits.begin(), digits.end(), 0);
 }
+
+// Aho-Corasick automaton over the number words, where every digit moves to
+// its own accepting state. No pattern contains another one, so matches come
+// out ordered by their start as well as by their end.
+struct DigitAutomaton {
+    static constexpr std::size_t MAX_STATES = 64;
+    static constexpr std::uint8_t ROOT = 0;
+
+    std::array<std::array<std::uint8_t, 256>, MAX_STATES> next{};
+    std::array<std::int8_t, MAX_STATES> output{};
+
+    static consteval auto build() -> DigitAutomaton {
+        constexpr std::array<std::string_view, 10> words {
+            "zero", "one", "two", "three", "four", "five", "six", "seven", "eight", "nine"
+        };
+
+        DigitAutomaton automaton{};
+        std::array<std::array<std::uint8_t, 256>, MAX_STATES> trie{};
+        std::array<std::uint8_t, MAX_STATES> fail{};
+        automaton.output.fill(-1);
+
+        std::size_t states = 1;
+        for (std::size_t digit = 0; digit < 10; ++digit) {
+            automaton.output[states] = digit;
+            automaton.next[ROOT]['0' + digit] = states++;
+        }
+
+        for (std::size_t digit = 0; digit < words.size(); ++digit) {
+            std::uint8_t state = ROOT;
+            for (auto const c : words[digit]) {
+                auto& child = trie[state][static_cast<std::uint8_t>(c)];
+                if (child == ROOT) {
+                    child = states++;
+                }
+                state = child;
+            }
+            automaton.output[state] = digit;
+        }
+
+        std::array<std::uint8_t, MAX_STATES> queue{};
+        std::size_t queue_head = 0;
+        std::size_t queue_tail = 0;
+
+        for (std::size_t c = 0; c < 256; ++c) {
+            if (auto const child = trie[ROOT][c]; child != ROOT) {
+                automaton.next[ROOT][c] = child;
+                queue[queue_tail++] = child;
+            }
+        }
+
+        while (queue_head < queue_tail) {
+            auto const state = queue[queue_head++];
+            for (std::size_t c = 0; c < 256; ++c) {
+                auto const child = trie[state][c];
+                if (child == ROOT) {
+                    automaton.next[state][c] = automaton.next[fail[state]][c];
+                    continue;
+                }
+
+                fail[child] = automaton.next[fail[state]][c];
+                if (automaton.output[child] < 0) {
+                    automaton.output[child] = automaton.output[fail[child]];
+                }
+                automaton.next[state][c] = child;
+                queue[queue_tail++] = child;
+            }
+        }
+
+        // Digit states carry on exactly like the root
+        for (std::size_t digit = 0; digit < 10; ++digit) {
+            automaton.next[1 + digit] = automaton.next[ROOT];
+        }
+
+        return automaton;
+    }
+
+    auto calibration_value(std::string_view calibration_line) const -> int {
+        int first_value = -1;
+        int last_value = -1;
+        std::uint8_t state = ROOT;
+
+        for (auto const c : calibration_line) {
+            state = this->next[state][static_cast<std::uint8_t>(c)];
+            if (auto const value = this->output[state]; value >= 0) {
+                first_value = (first_value < 0) ? value : first_value;
+                last_value = value;
+            }
+        }
+
+        return (first_value * 10) + last_value;
+    }
+};
+
+static constexpr DigitAutomaton DIGIT_AUTOMATON = DigitAutomaton::build();
+
+auto AoC2023::day1_part2_automaton(SolutionInput input) -> SolutionReturn {
+    SolutionReturn acc = 0;
+    for (auto const& calibration_line : input) {
+        acc += DIGIT_AUTOMATON.calibration_value(calibration_line);
+    }
+
+    return acc;
+}
@@ -0,0 +1,9 @@
+#pragma once
+
+#include <string_view>
+
+#include "solution.hpp"
+
+// Sum of the part 1 calibration values of a raw, newline separated buffer,
+// throws std::out_of_range on a line without any digit
+auto sum_calibration_values(std::string_view calibration_buffer) -> SolutionReturn;
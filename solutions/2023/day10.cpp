@@ -16,43 +16,12 @@
 
 #include "aoc2023.hpp"
 #include "solution.hpp"
+#include "day10.hpp"
 
 // TODO: Refactor ALL of this to not be so hacky and haphazard
 // TODO: Ensure that axis convention is consistent x = columns, y = rows => i = y, j = x
 // TODO: Possibly use trigometric functions to determine directions and offsets
 
-struct Vec2 {
-    int x;
-    int y;
-
-    friend auto operator==(Vec2 const& lhs, Vec2 const& rhs) -> bool {
-        return lhs.x == rhs.x && lhs.y == rhs.y;
-    }
-
-    friend auto operator!=(Vec2 const& lhs, Vec2 const& rhs) -> bool {
-        return lhs.x != rhs.x || lhs.y != rhs.y;
-    }
-
-    friend auto operator+=(Vec2& lhs, Vec2 const& rhs) -> void {
-        lhs.x += rhs.x;
-        lhs.y += rhs.y;
-    }
-};
-
-enum Direction : int {
-    None       = 0,
-    North      = 1,
-    East       = 2,
-    NorthEast  = 3,
-    South      = 4,
-    NorthSouth = 5,
-    SouthEast  = 6,
-    West       = 8,
-    NorthWest  = 9,
-    EastWest   = 10,
-    SouthWest  = 12,
-};
-
 auto opposite(Direction direction) -> Direction {
     using type = std::underlying_type_t<Direction>;
     bool wrap_around = direction >= Direction::South;
@@ -144,89 +113,6 @@ auto to_name(Direction const direction) -> std::string_view {
     return "<UNKNOWN>";
 }
 
-struct Pipe {
-    enum Type : int {
-        Vertical   = '|',
-        Horizontal = '-',
-        BendNE     = 'L',
-        BendNW     = 'J',
-        BendSW     = '7',
-        BendSE     = 'F',
-        Ground     = '.',
-        Unknown    = 'S'
-    };
-
-    static auto valid_symbol(char c) -> bool {
-        switch (static_cast<Type>(c)) {
-            case Vertical:   // FALLTHROUGH
-            case Horizontal: // FALLTHROUGH
-            case BendNE:     // FALLTHROUGH
-            case BendNW:     // FALLTHROUGH
-            case BendSW:     // FALLTHROUGH
-            case BendSE:     // FALLTHROUGH
-            case Ground:     // FALLTHROUGH
-            case Unknown:    { return true; }
-            default:         { return false; }
-        }
-
-        return false;
-    }
-
-    static auto to_direction(Type const pipe) -> Direction {
-        using enum Direction;
-        switch (pipe) {
-            case Vertical:   { return NorthSouth; }
-            case Horizontal: { return EastWest; }
-            case BendNE:     { return NorthEast; }
-            case BendNW:     { return NorthWest; }
-            case BendSW:     { return SouthWest; }
-            case BendSE:     { return SouthEast; }
-            case Ground:     { return None; }
-            case Unknown:    { return None; }
-            default:         { return None; }
-        }
-
-        return None;
-    }
-
-    static auto from_direction(Direction direction) -> Pipe::Type {
-        using enum Direction;
-        switch (direction) {
-            case NorthSouth: { return Vertical; }
-            case EastWest:   { return Horizontal; }
-            case NorthWest:  { return BendNW; }
-            case NorthEast:  { return BendNE; }
-            case SouthWest:  { return BendSW; }
-            case SouthEast:  { return BendSE; }
-            default:         { return Ground; }
-        }
-
-        return Ground;
-    }
-
-    static auto offsets(Type const pipe_in) -> Vec2 {
-        auto const [x_offset, y_offset] = to_relative_offsets(Pipe::to_direction(pipe_in));
-        return {
-            x_offset,
-            y_offset
-        };
-    }
-
-    static auto split_directions(Type const pipe_in) -> std::pair<Direction, Direction> {
-        auto const [first, second] = to_pair(Pipe::to_direction(pipe_in));
-
-        return {
-            first,
-            second
-        };
-    }
-
-    Type pipe;
-};
-
-using pipe_entry_type = std::vector<Pipe>;
-using pipe_map_type = std::vector<pipe_entry_type>;
-
 auto parse_pipe_map(SolutionInput pipe_sketch) -> std::pair<Vec2, pipe_map_type> {
     pipe_map_type pipe_map{};
     pipe_map.resize(pipe_sketch.size());
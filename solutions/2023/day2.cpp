@@ -3,6 +3,7 @@
 #include <iterator>
 #include <tuple>
 #include <numeric>
+#include <span>
 #include <string>
 #include <string_view>
 #include <array>
@@ -12,6 +13,7 @@
 
 #include "aoc2023.hpp"
 #include "solution.hpp"
+#include "day2.hpp"
 
 struct RoundCube {
     int r = 0;
@@ -136,3 +138,200 @@ auto AoC2023::day2_part2(SolutionInput input) -> SolutionReturn {
 
     return acc;
 }
+
+// Single pass over the bytes of every game record. A colour is told apart
+// by its first letter, after which the rest of its name is skipped.
+auto parse_game_columns(SolutionInput game_records) -> GameColumns {
+    static constexpr std::array<std::size_t, 3> COLOR_NAME_LENGTHS { 3, 5, 4 };
+
+    GameColumns columns{};
+    columns.id.reserve(game_records.size());
+    columns.red.reserve(game_records.size());
+    columns.green.reserve(game_records.size());
+    columns.blue.reserve(game_records.size());
+
+    for (auto const& record : game_records) {
+        std::size_t i = 0;
+        while (i < record.size() && !std::isdigit(record[i])) { ++i; }
+
+        int id = 0;
+        for (; i < record.size() && record[i] != ':'; ++i) {
+            id = id * 10 + (record[i] - '0');
+        }
+
+        std::array<int, 3> round{};
+        std::array<int, 3> maximum{};
+        int value = 0;
+
+        for (++i; i < record.size(); ++i) {
+            char const c = record[i];
+            if (c >= '0' && c <= '9') {
+                value = value * 10 + (c - '0');
+            } else if (c == 'r' || c == 'g' || c == 'b') {
+                std::size_t const color = (c == 'g') + 2 * (c == 'b');
+                round[color] += value;
+                value = 0;
+                i += COLOR_NAME_LENGTHS[color] - 1;
+            } else if (c == ';') {
+                for (std::size_t j = 0; j < 3; ++j) {
+                    maximum[j] = std::max(maximum[j], round[j]);
+                    round[j] = 0;
+                }
+            }
+        }
+
+        for (std::size_t j = 0; j < 3; ++j) {
+            maximum[j] = std::max(maximum[j], round[j]);
+        }
+
+        columns.id.push_back(id);
+        columns.red.push_back(maximum[0]);
+        columns.green.push_back(maximum[1]);
+        columns.blue.push_back(maximum[2]);
+    }
+
+    return columns;
+}
+
+auto AoC2023::day2_part1_columns(SolutionInput input) -> SolutionReturn {
+    int const max_red = 12;
+    int const max_green = 13;
+    int const max_blue = 14;
+
+    auto const columns = parse_game_columns(input);
+    SolutionReturn acc = 0;
+    for (std::size_t i = 0; i < columns.id.size(); ++i) {
+        bool const valid_game = (columns.red[i] <= max_red) & (columns.green[i] <= max_green) & (columns.blue[i] <= max_blue);
+        acc += columns.id[i] * static_cast<int>(valid_game);
+    }
+
+    return acc;
+}
+
+auto AoC2023::day2_part2_columns(SolutionInput input) -> SolutionReturn {
+    auto const columns = parse_game_columns(input);
+    SolutionReturn acc = 0;
+    for (std::size_t i = 0; i < columns.id.size(); ++i) {
+        acc += columns.red[i] * columns.green[i] * columns.blue[i];
+    }
+
+    return acc;
+}
+
+GameLimitIndex::GameLimitIndex(GameColumns const& columns) {
+    auto const distinct_values = [](std::vector<int> values) {
+        std::ranges::sort(values);
+        auto const [first, last] = std::ranges::unique(values);
+        values.erase(first, last);
+        return values;
+    };
+
+    this->red_values = distinct_values(columns.red);
+    this->green_values = distinct_values(columns.green);
+    this->blue_values = distinct_values(columns.blue);
+
+    std::size_t const cells = (this->red_values.size() + 1)
+                            * (this->green_values.size() + 1)
+                            * (this->blue_values.size() + 1);
+
+    if (cells > MAX_TABLE_CELLS) {
+        this->red_values.clear();
+        this->green_values.clear();
+        this->blue_values.clear();
+
+        std::vector<std::size_t> order(columns.id.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::ranges::sort(order, {}, [&columns](std::size_t i) { return columns.red[i]; });
+
+        for (auto const i : order) {
+            this->sorted_games.id.push_back(columns.id[i]);
+            this->sorted_games.red.push_back(columns.red[i]);
+            this->sorted_games.green.push_back(columns.green[i]);
+            this->sorted_games.blue.push_back(columns.blue[i]);
+        }
+
+        return;
+    }
+
+    // Every game adds its id to the cell of its compressed coordinates, three
+    // prefix sum passes then turn each cell into the sum of all games it
+    // dominates
+    this->prefix.assign(cells, 0);
+    auto const coordinate = [](std::vector<int> const& values, int value) {
+        return static_cast<std::size_t>(std::ranges::lower_bound(values, value) - values.begin()) + 1;
+    };
+
+    for (std::size_t i = 0; i < columns.id.size(); ++i) {
+        this->prefix[this->cell(coordinate(this->red_values, columns.red[i]),
+                                coordinate(this->green_values, columns.green[i]),
+                                coordinate(this->blue_values, columns.blue[i]))] += columns.id[i];
+    }
+
+    std::size_t const red_size = this->red_values.size() + 1;
+    std::size_t const green_size = this->green_values.size() + 1;
+    std::size_t const blue_size = this->blue_values.size() + 1;
+
+    for (std::size_t r = 1; r < red_size; ++r) {
+        for (std::size_t g = 0; g < green_size; ++g) {
+            for (std::size_t b = 0; b < blue_size; ++b) {
+                this->prefix[this->cell(r, g, b)] += this->prefix[this->cell(r - 1, g, b)];
+            }
+        }
+    }
+
+    for (std::size_t r = 0; r < red_size; ++r) {
+        for (std::size_t g = 1; g < green_size; ++g) {
+            for (std::size_t b = 0; b < blue_size; ++b) {
+                this->prefix[this->cell(r, g, b)] += this->prefix[this->cell(r, g - 1, b)];
+            }
+        }
+    }
+
+    for (std::size_t r = 0; r < red_size; ++r) {
+        for (std::size_t g = 0; g < green_size; ++g) {
+            for (std::size_t b = 1; b < blue_size; ++b) {
+                this->prefix[this->cell(r, g, b)] += this->prefix[this->cell(r, g, b - 1)];
+            }
+        }
+    }
+}
+
+auto GameLimitIndex::cell(std::size_t r, std::size_t g, std::size_t b) const -> std::size_t {
+    return (r * (this->green_values.size() + 1) + g) * (this->blue_values.size() + 1) + b;
+}
+
+auto GameLimitIndex::feasible_id_sum(GameBag bag) const -> SolutionReturn {
+    if (this->prefix.empty()) {
+        auto const candidates = std::ranges::upper_bound(this->sorted_games.red, bag.red) - this->sorted_games.red.begin();
+        SolutionReturn acc = 0;
+        for (std::ptrdiff_t i = 0; i < candidates; ++i) {
+            bool const valid_game = (this->sorted_games.green[i] <= bag.green) & (this->sorted_games.blue[i] <= bag.blue);
+            acc += this->sorted_games.id[i] * static_cast<int>(valid_game);
+        }
+
+        return acc;
+    }
+
+    auto const coordinate = [](std::vector<int> const& values, int value) {
+        return static_cast<std::size_t>(std::ranges::upper_bound(values, value) - values.begin());
+    };
+
+    return this->prefix[this->cell(coordinate(this->red_values, bag.red),
+                                   coordinate(this->green_values, bag.green),
+                                   coordinate(this->blue_values, bag.blue))];
+}
+
+auto GameLimitIndex::feasible_id_sums(std::span<GameBag const> bags) const -> std::vector<SolutionReturn> {
+    std::vector<SolutionReturn> sums{};
+    sums.reserve(bags.size());
+    for (auto const bag : bags) {
+        sums.push_back(this->feasible_id_sum(bag));
+    }
+
+    return sums;
+}
+
+auto AoC2023::day2_part1_index(SolutionInput input) -> SolutionReturn {
+    GameLimitIndex const index{ parse_game_columns(input) };
+    return index.feasible_id_sum({ 12, 13, 14 });
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include "solution.hpp"
+
+// Per-game maximum cube counts, one column per colour
+struct GameColumns {
+    std::vector<int> id;
+    std::vector<int> red;
+    std::vector<int> green;
+    std::vector<int> blue;
+};
+
+struct GameBag {
+    int red;
+    int green;
+    int blue;
+};
+
+// Answers "sum of the ids of all games possible with this bag" for any number
+// of bags. The per-game maxima are compressed to their distinct values per
+// colour and summed into a 3-D dominance table, so that a query is three
+// binary searches and one load. Game logs whose table would be too large fall
+// back to columns sorted by red, where a query only scans the games with few
+// enough red cubes.
+struct GameLimitIndex {
+    static constexpr std::size_t MAX_TABLE_CELLS = 1 << 22;
+
+    explicit GameLimitIndex(GameColumns const& columns);
+
+    auto feasible_id_sum(GameBag bag) const -> SolutionReturn;
+    auto feasible_id_sums(std::span<GameBag const> bags) const -> std::vector<SolutionReturn>;
+
+private:
+    auto cell(std::size_t r, std::size_t g, std::size_t b) const -> std::size_t;
+
+    std::vector<int> red_values;
+    std::vector<int> green_values;
+    std::vector<int> blue_values;
+    std::vector<SolutionReturn> prefix;
+    GameColumns sorted_games;
+};
+
+auto parse_game_columns(SolutionInput game_records) -> GameColumns;
@@ -1,4 +1,6 @@
 #include <algorithm>
+#include <bit>
+#include <cstdint>
 #include <numeric>
 #include <string>
 #include <string_view>
@@ -8,28 +10,22 @@
 #include <map>
 #include <unordered_map>
 #include <set>
+#include <span>
 #include <fmt/core.h>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 #include "aoc2023.hpp"
 #include "solution.hpp"
+#include "day3.hpp"
+#include "parallel.hpp"
 
 static constexpr std::array SYMBOLS_TABLE {
     '@', '#', '$', '%', '&', '*', '-', '=', '+', '/'
 };
 
-struct SchematicNumber {
-    std::string_view number;
-    int value;
-    std::size_t row;
-    std::size_t column;
-};
-
-struct SymbolCoordinate {
-    char symbol;
-    std::size_t row;
-    std::size_t column;
-};
-
 template<typename T>
 auto parse_schematic_numbers(T const& schematic_lines) -> std::vector<SchematicNumber> {
     std::vector<SchematicNumber> schematic_numbers{};
@@ -74,32 +70,14 @@ auto parse_schematic_map(T const& schematic_lines, char search_symbol = '\0') ->
     schematic_map_type number_map{};
     std::vector<SymbolCoordinate> symbol_coordinates{};
 
+    for (auto const& number : parse_schematic_numbers(schematic_lines)) {
+        number_map[number.row].push_back(number);
+    }
+
     std::size_t i = 0;
     for (auto const& line : schematic_lines) {
-        bool cursor_enable = std::isdigit(line.front());
-        bool insert_number = false;
-        auto cursor_start = line.begin();
-        std::size_t j = 0;
-        for (auto c = line.begin(); c != line.end(); ++c) {
-            if (*c == search_symbol) { symbol_coordinates.emplace_back(*c, i, j); }
-            if (std::isdigit(*c) && !cursor_enable) {
-                cursor_enable = true;
-                cursor_start = c;
-            } else if (!std::isdigit(*c) && cursor_enable) {
-                cursor_enable = false;
-                insert_number = true;
-            }
-            if (insert_number || (j == line.size() - 1 && cursor_enable)) {
-                insert_number = false;
-                const std::string_view number{cursor_start, (cursor_enable) ? line.end() : c};
-                number_map[i].emplace_back(
-                    number,
-                    std::stoi(std::string{number}),
-                    i,
-                    std::max(0uz, j - number.size())
-                );
-            }
-            ++j;
+        for (std::size_t j = 0; j < line.size(); ++j) {
+            if (line[j] == search_symbol) { symbol_coordinates.emplace_back(line[j], i, j); }
         }
         ++i;
     }
@@ -144,7 +122,13 @@ auto AoC2023::day3_part2(SolutionInput input) -> SolutionReturn {
         int multiplier = 0;
 
         for (std::size_t i = min_r; i <= std::min(input.size() - 1, symbol.row + 1); ++i) {
-            for (const auto& number : schematic_map.at(i)) {
+            // Rows without numbers have no entry
+            auto const row = schematic_map.find(static_cast<int>(i));
+            if (row == schematic_map.end()) {
+                continue;
+            }
+
+            for (const auto& number : row->second) {
                 std::size_t max_c = std::min(input[i].size() - 1, symbol.column + 1);
                 bool start_between_range = min_c <= number.column && number.column <= max_c;
                 bool end_between_range =  min_c <= number.column + number.number.size() - 1 && number.column + number.number.size() - 1 <= max_c;
@@ -164,3 +148,298 @@ auto AoC2023::day3_part2(SolutionInput input) -> SolutionReturn {
 
     return acc;
 }
+
+auto SchematicGrid::from_lines(std::span<std::string const> schematic_lines) -> SchematicGrid {
+    std::size_t width = 0;
+    for (auto const& line : schematic_lines) {
+        width = std::max(width, line.size());
+    }
+
+    SchematicGrid grid{};
+    grid.rows = schematic_lines.size() + 2;
+    grid.stride = (width + 2 + WORD_BITS - 1) / WORD_BITS * WORD_BITS;
+    grid.cells.assign(grid.rows * grid.stride, '.');
+
+    for (std::size_t i = 0; i < schematic_lines.size(); ++i) {
+        std::ranges::copy(schematic_lines[i], grid.cells.begin() + (i + 1) * grid.stride + 1);
+    }
+
+    return grid;
+}
+
+static constexpr std::size_t BLOCK_SIZE = 16;
+
+// Bit i is set when byte i of the block is one of SYMBOLS_TABLE
+static auto symbol_block_mask(char const* block) -> std::uint64_t {
+#if defined(__SSE2__)
+    auto const bytes = _mm_loadu_si128(reinterpret_cast<__m128i const*>(block));
+    auto symbols = _mm_setzero_si128();
+    for (auto const symbol : SYMBOLS_TABLE) {
+        symbols = _mm_or_si128(symbols, _mm_cmpeq_epi8(bytes, _mm_set1_epi8(symbol)));
+    }
+    return static_cast<std::uint64_t>(static_cast<std::uint32_t>(_mm_movemask_epi8(symbols)));
+#else
+    std::uint64_t mask = 0;
+    for (std::size_t i = 0; i < BLOCK_SIZE; ++i) {
+        mask |= static_cast<std::uint64_t>(std::ranges::find(SYMBOLS_TABLE, block[i]) != SYMBOLS_TABLE.end()) << i;
+    }
+    return mask;
+#endif
+}
+
+// Bit i is set when byte i of the block is an ASCII digit
+static auto digit_block_mask(char const* block) -> std::uint64_t {
+#if defined(__SSE2__)
+    auto const bytes = _mm_loadu_si128(reinterpret_cast<__m128i const*>(block));
+    auto const offsets = _mm_sub_epi8(bytes, _mm_set1_epi8('0'));
+    auto const digits = _mm_cmpeq_epi8(_mm_min_epu8(offsets, _mm_set1_epi8(9)), offsets);
+    return static_cast<std::uint64_t>(static_cast<std::uint32_t>(_mm_movemask_epi8(digits)));
+#else
+    std::uint64_t mask = 0;
+    for (std::size_t i = 0; i < BLOCK_SIZE; ++i) {
+        mask |= static_cast<std::uint64_t>(block[i] >= '0' && block[i] <= '9') << i;
+    }
+    return mask;
+#endif
+}
+
+template<typename F>
+static auto classify_schematic(SchematicGrid const& grid, F&& block_mask) -> schematic_mask_type {
+    schematic_mask_type mask(grid.cells.size() / SchematicGrid::WORD_BITS);
+    char const* block = grid.cells.data();
+
+    for (auto& word : mask) {
+        for (std::size_t i = 0; i < SchematicGrid::WORD_BITS; i += BLOCK_SIZE, block += BLOCK_SIZE) {
+            word |= block_mask(block) << i;
+        }
+    }
+
+    return mask;
+}
+
+auto schematic_symbol_mask(SchematicGrid const& grid) -> schematic_mask_type {
+    return classify_schematic(grid, symbol_block_mask);
+}
+
+auto schematic_digit_mask(SchematicGrid const& grid) -> schematic_mask_type {
+    return classify_schematic(grid, digit_block_mask);
+}
+
+// Every set bit also sets its eight neighbours. The border of the grid keeps
+// bits from leaking between rows, so only the words of a row need carries.
+auto dilate_schematic_mask(SchematicGrid const& grid, schematic_mask_type const& mask) -> schematic_mask_type {
+    std::size_t const words = grid.words();
+    schematic_mask_type horizontal(mask.size());
+
+    for (std::size_t r = 0; r < grid.rows; ++r) {
+        auto const* row = mask.data() + r * words;
+        for (std::size_t w = 0; w < words; ++w) {
+            std::uint64_t const left = (w > 0) ? row[w - 1] >> 63 : 0;
+            std::uint64_t const right = (w + 1 < words) ? row[w + 1] << 63 : 0;
+            horizontal[r * words + w] = row[w] | (row[w] << 1) | left | (row[w] >> 1) | right;
+        }
+    }
+
+    schematic_mask_type dilated(mask.size());
+    for (std::size_t r = 1; r + 1 < grid.rows; ++r) {
+        for (std::size_t w = 0; w < words; ++w) {
+            dilated[r * words + w] = horizontal[(r - 1) * words + w]
+                                   | horizontal[r * words + w]
+                                   | horizontal[(r + 1) * words + w];
+        }
+    }
+
+    return dilated;
+}
+
+// Only digit runs with at least one cell in the dilated symbol mask are
+// visited, each run is then parsed from the byte grid once
+auto sum_part_numbers(SchematicGrid const& grid) -> SolutionReturn {
+    auto const digits = schematic_digit_mask(grid);
+    auto const adjacent = dilate_schematic_mask(grid, schematic_symbol_mask(grid));
+    std::size_t const words = grid.words();
+    SolutionReturn acc = 0;
+
+    for (std::size_t r = 1; r + 1 < grid.rows; ++r) {
+        char const* row = grid.cells.data() + r * grid.stride;
+        std::size_t next = 0;
+
+        for (std::size_t w = 0; w < words; ++w) {
+            std::size_t const base = w * SchematicGrid::WORD_BITS;
+            std::uint64_t hits = digits[r * words + w] & adjacent[r * words + w];
+            hits &= (next > base) ? ~0ull << std::min<std::size_t>(next - base, 63) : ~0ull;
+            hits = (next >= base + SchematicGrid::WORD_BITS) ? 0 : hits;
+
+            while (hits != 0) {
+                std::size_t first = base + std::countr_zero(hits);
+                while (row[first - 1] >= '0' && row[first - 1] <= '9') {
+                    --first;
+                }
+
+                SolutionReturn value = 0;
+                std::size_t last = first;
+                for (; row[last] >= '0' && row[last] <= '9'; ++last) {
+                    value = value * 10 + (row[last] - '0');
+                }
+
+                acc += value;
+                next = last;
+                hits = (last - base < SchematicGrid::WORD_BITS) ? hits & (~0ull << (last - base)) : 0;
+            }
+        }
+    }
+
+    return acc;
+}
+
+auto AoC2023::day3_part1_grid(SolutionInput input) -> SolutionReturn {
+    return sum_part_numbers(SchematicGrid::from_lines(input));
+}
+
+auto SchematicLabels::from_grid(SchematicGrid const& grid) -> SchematicLabels {
+    auto const digits = schematic_digit_mask(grid);
+    auto const symbol_cells = schematic_symbol_mask(grid);
+    std::size_t const words = grid.words();
+
+    // A number starts at every digit without a digit to its left
+    schematic_mask_type starts(digits.size());
+    std::size_t number_count = 0;
+    std::size_t symbol_count = 0;
+    for (std::size_t w = 0; w < digits.size(); ++w) {
+        std::uint64_t const carry = (w % words > 0) ? digits[w - 1] >> 63 : 0;
+        starts[w] = digits[w] & ~((digits[w] << 1) | carry);
+        number_count += std::popcount(starts[w]);
+        symbol_count += std::popcount(symbol_cells[w]);
+    }
+
+    SchematicLabels labels{};
+    labels.labels.assign(grid.cells.size(), 0);
+    labels.numbers.reserve(number_count);
+    labels.symbols.reserve(symbol_count);
+
+    for (std::size_t w = 0; w < starts.size(); ++w) {
+        std::size_t const base = w * SchematicGrid::WORD_BITS;
+
+        for (auto bits = starts[w]; bits != 0; bits &= bits - 1) {
+            std::size_t const first = base + std::countr_zero(bits);
+            auto const label = static_cast<std::uint32_t>(labels.numbers.size() + 1);
+
+            int value = 0;
+            std::size_t last = first;
+            for (; grid.cells[last] >= '0' && grid.cells[last] <= '9'; ++last) {
+                value = value * 10 + (grid.cells[last] - '0');
+                labels.labels[last] = label;
+            }
+
+            labels.numbers.emplace_back(
+                std::string_view{ grid.cells.data() + first, last - first },
+                value,
+                first / grid.stride - 1,
+                first % grid.stride - 1
+            );
+        }
+
+        for (auto bits = symbol_cells[w]; bits != 0; bits &= bits - 1) {
+            std::size_t const cell = base + std::countr_zero(bits);
+            labels.symbols.emplace_back(grid.cells[cell], cell / grid.stride - 1, cell % grid.stride - 1);
+        }
+    }
+
+    return labels;
+}
+
+// Numbers in one row are separated by at least one unlabeled cell, so a
+// repeated label among three neighbouring cells is always a repeat of the cell
+// to its left, and rows never share labels
+auto SchematicLabels::neighbours(SchematicGrid const& grid, SymbolCoordinate symbol) const -> neighbour_labels_type {
+    neighbour_labels_type found{};
+    std::size_t const center = (symbol.row + 1) * grid.stride + symbol.column + 1;
+
+    for (auto const row : { center - grid.stride, center, center + grid.stride }) {
+        std::uint32_t previous = 0;
+        for (auto const cell : { row - 1, row, row + 1 }) {
+            auto const label = this->labels[cell];
+            found.labels[found.count] = label;
+            found.count += (label != 0 && label != previous);
+            previous = label;
+        }
+    }
+
+    return found;
+}
+
+auto sum_schematic(SchematicGrid const& grid) -> SchematicSums {
+    return sum_schematic(grid, 0, grid.rows - 2);
+}
+
+// Symbols outside the owned rows still mark the owned numbers next to them,
+// but only owned numbers and owned gears are summed
+auto sum_schematic(SchematicGrid const& grid, std::size_t first_row, std::size_t last_row) -> SchematicSums {
+    auto const labels = SchematicLabels::from_grid(grid);
+    std::vector<bool> is_part_number(labels.numbers.size(), false);
+    SchematicSums sums{};
+
+    for (auto const symbol : labels.symbols) {
+        auto const found = labels.neighbours(grid, symbol);
+        for (std::size_t i = 0; i < found.count; ++i) {
+            is_part_number[found.labels[i] - 1] = true;
+        }
+
+        bool const owned = first_row <= symbol.row && symbol.row < last_row;
+        if (owned && symbol.symbol == '*' && found.count == 2) {
+            sums.gear_ratios += static_cast<SolutionReturn>(labels.numbers[found.labels[0] - 1].value)
+                              * labels.numbers[found.labels[1] - 1].value;
+        }
+    }
+
+    for (std::size_t i = 0; i < labels.numbers.size(); ++i) {
+        bool const owned = first_row <= labels.numbers[i].row && labels.numbers[i].row < last_row;
+        sums.part_numbers += (owned && is_part_number[i]) ? labels.numbers[i].value : 0;
+    }
+
+    return sums;
+}
+
+static constexpr std::size_t SCHEMATIC_TILE_ROWS = 2048;
+
+// Numbers never span rows, so every number and every gear is owned by the
+// tile holding its row. The halo rows supply the neighbours a tile needs to
+// decide on its own rows.
+auto sum_schematic_tiled(std::span<std::string const> schematic_lines, std::size_t max_threads) -> SchematicSums {
+    std::size_t const tiles = (schematic_lines.size() + SCHEMATIC_TILE_ROWS - 1) / SCHEMATIC_TILE_ROWS;
+    std::vector<SchematicSums> tile_sums(tiles);
+
+    parallel::for_each_index(tiles, [&](std::size_t tile) {
+        std::size_t const first = tile * SCHEMATIC_TILE_ROWS;
+        std::size_t const last = std::min(first + SCHEMATIC_TILE_ROWS, schematic_lines.size());
+        std::size_t const halo_first = (first > 0) ? first - 1 : first;
+        std::size_t const halo_last = std::min(last + 1, schematic_lines.size());
+
+        auto const grid = SchematicGrid::from_lines(schematic_lines.subspan(halo_first, halo_last - halo_first));
+        tile_sums[tile] = sum_schematic(grid, first - halo_first, last - halo_first);
+    }, max_threads);
+
+    SchematicSums sums{};
+    for (auto const& tile : tile_sums) {
+        sums.part_numbers += tile.part_numbers;
+        sums.gear_ratios += tile.gear_ratios;
+    }
+
+    return sums;
+}
+
+auto AoC2023::day3_part1_labels(SolutionInput input) -> SolutionReturn {
+    return sum_schematic(SchematicGrid::from_lines(input)).part_numbers;
+}
+
+auto AoC2023::day3_part2_labels(SolutionInput input) -> SolutionReturn {
+    return sum_schematic(SchematicGrid::from_lines(input)).gear_ratios;
+}
+
+auto AoC2023::day3_part1_tiled(SolutionInput input) -> SolutionReturn {
+    return sum_schematic_tiled(input, parallel::concurrency()).part_numbers;
+}
+
+auto AoC2023::day3_part2_tiled(SolutionInput input) -> SolutionReturn {
+    return sum_schematic_tiled(input, parallel::concurrency()).gear_ratios;
+}
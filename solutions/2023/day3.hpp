@@ -0,0 +1,85 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "solution.hpp"
+
+struct SchematicNumber {
+    std::string_view number;
+    int value;
+    std::size_t row;
+    std::size_t column;
+};
+
+struct SymbolCoordinate {
+    char symbol;
+    std::size_t row;
+    std::size_t column;
+};
+
+// Schematic copied into one contiguous byte grid with a border of '.' on every
+// side. Rows are padded to a whole number of 64-bit mask words, so that cell
+// (i, j) of the input is byte (i + 1) * stride + j + 1 and bit j + 1 of the
+// mask words of row i + 1.
+struct SchematicGrid {
+    static constexpr std::size_t WORD_BITS = 64;
+
+    std::size_t rows;
+    std::size_t stride;
+    std::vector<char> cells;
+
+    static auto from_lines(std::span<std::string const> schematic_lines) -> SchematicGrid;
+
+    auto words() const -> std::size_t {
+        return this->stride / WORD_BITS;
+    }
+};
+
+// One bit per cell of the grid, rows of SchematicGrid::words() words each
+using schematic_mask_type = std::vector<std::uint64_t>;
+
+auto schematic_symbol_mask(SchematicGrid const& grid) -> schematic_mask_type;
+auto schematic_digit_mask(SchematicGrid const& grid) -> schematic_mask_type;
+auto dilate_schematic_mask(SchematicGrid const& grid, schematic_mask_type const& mask) -> schematic_mask_type;
+auto sum_part_numbers(SchematicGrid const& grid) -> SolutionReturn;
+
+// Every cell of a number holds that number's id, its index in `numbers` plus
+// one, and every other cell holds 0. Symbols then find their adjacent numbers
+// by reading the eight labels around them.
+struct SchematicLabels {
+    struct neighbour_labels_type {
+        std::array<std::uint32_t, 8> labels;
+        std::size_t count;
+    };
+
+    std::vector<std::uint32_t> labels;
+    std::vector<SchematicNumber> numbers;
+    std::vector<SymbolCoordinate> symbols;
+
+    static auto from_grid(SchematicGrid const& grid) -> SchematicLabels;
+
+    // Distinct ids of the numbers adjacent to the symbol
+    auto neighbours(SchematicGrid const& grid, SymbolCoordinate symbol) const -> neighbour_labels_type;
+};
+
+struct SchematicSums {
+    SolutionReturn part_numbers;
+    SolutionReturn gear_ratios;
+};
+
+// Both parts from a single labeling pass
+auto sum_schematic(SchematicGrid const& grid) -> SchematicSums;
+
+// Both parts for the numbers and gears of input rows [first_row, last_row) of
+// the grid only, the other rows just provide their neighbours
+auto sum_schematic(SchematicGrid const& grid, std::size_t first_row, std::size_t last_row) -> SchematicSums;
+
+// Both parts over horizontal tiles with a one-row halo, labeled on up to
+// max_threads threads of the shared pool
+auto sum_schematic_tiled(std::span<std::string const> schematic_lines, std::size_t max_threads) -> SchematicSums;
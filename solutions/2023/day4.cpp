@@ -1,17 +1,21 @@
 #include <algorithm>
+#include <bitset>
 #include <cctype>
 #include <cmath>
+#include <limits>
 #include <numeric>
+#include <span>
+#include <stdexcept>
 #include <string>
 #include <string_view>
 #include <array>
 #include <vector>
 #include <ranges>
-#include <map>
 #include <fmt/core.h>
 
 #include "aoc2023.hpp"
 #include "solution.hpp"
+#include "day4.hpp"
 
 struct ScratchCard {
     int id;
@@ -71,17 +75,6 @@ auto parse_scratch_cards(T const& scratch_cards_input) -> std::vector<ScratchCar
     return scratch_cards;
 }
 
-template<typename T>
-auto map_total_scratch_cards(T const& scratch_cards) -> std::map<int, int> {
-    std::map<int, int> total_scratch_cards{};
-
-    for (const auto& card : scratch_cards) {
-        total_scratch_cards[card.id] += 1;
-    }
-
-    return total_scratch_cards;
-}
-
 auto AoC2023::day4_part1(SolutionInput input) -> SolutionReturn {
     auto scratch_cards = parse_scratch_cards(input);
     int acc = 0;
@@ -107,8 +100,8 @@ auto AoC2023::day4_part1(SolutionInput input) -> SolutionReturn {
 
 auto AoC2023::day4_part2(SolutionInput input) -> SolutionReturn {
     auto scratch_cards = parse_scratch_cards(input);
-    auto total_scratch_cards = map_total_scratch_cards(scratch_cards);
-    int max_id = scratch_cards.back().id;
+    std::vector<int> card_matches{};
+    card_matches.reserve(scratch_cards.size());
 
     for (auto const& card : scratch_cards) {
         int winning_numbers = 0;
@@ -121,15 +114,104 @@ auto AoC2023::day4_part2(SolutionInput input) -> SolutionReturn {
             }
         }
 
-        for (int i = total_scratch_cards.at(card.id); i > 0; --i) {
-            for (int id = card.id + 1; id <= std::min(max_id, card.id + winning_numbers); ++id) {
-                total_scratch_cards[id] += 1;
+        card_matches.push_back(winning_numbers);
+    }
+
+    return count_scratch_cards(card_matches);
+}
+
+// Every card adds its copy count to a window of the cards after it. The
+// window is written as two entries of a difference array, so each card costs
+// the same no matter how many copies or matches it has.
+auto count_scratch_cards(std::span<int const> card_matches) -> SolutionReturn {
+    static constexpr SolutionReturn MAX_CARDS = std::numeric_limits<SolutionReturn>::max();
+
+    std::vector<SolutionReturn> won_copies(card_matches.size() + 1, 0);
+    SolutionReturn window_copies = 0;
+    SolutionReturn total_cards = 0;
+
+    for (std::size_t card = 0; card < card_matches.size(); ++card) {
+        window_copies += won_copies[card];
+        if (window_copies >= MAX_CARDS - total_cards) {
+            throw std::overflow_error("scratch card count does not fit in 64 bits");
+        }
+
+        SolutionReturn const copies = window_copies + 1;
+        total_cards += copies;
+
+        if (card_matches[card] > 0) {
+            won_copies[card + 1] += copies;
+            won_copies[std::min(card_matches.size(), card + 1 + card_matches[card])] -= copies;
+        }
+    }
+
+    return total_cards;
+}
+
+// Both sides are parsed straight into bit masks, so a card's match count is
+// a single popcount. Numbers of 128 or more throw std::out_of_range.
+auto parse_card_matches(SolutionInput scratch_cards_input) -> std::vector<int> {
+    std::vector<int> card_matches{};
+    card_matches.reserve(scratch_cards_input.size());
+
+    for (auto const& line : scratch_cards_input) {
+        std::array<card_numbers_type, 2> sides{};
+        std::size_t side = 0;
+        std::size_t number = 0;
+        bool in_number = false;
+
+        for (auto c = line.begin() + line.find(':') + 1; c != line.end(); ++c) {
+            if (*c >= '0' && *c <= '9') {
+                number = number * 10 + static_cast<std::size_t>(*c - '0');
+                in_number = true;
+                continue;
             }
+
+            if (in_number) {
+                sides.at(side).set(number);
+            }
+
+            side += (*c == '|');
+            number = 0;
+            in_number = false;
+        }
+
+        if (in_number) {
+            sides.at(side).set(number);
+        }
+
+        card_matches.push_back(static_cast<int>((sides[0] & sides[1]).count()));
+    }
+
+    return card_matches;
+}
+
+// A card of 128 possible numbers can match more than 63 of them, whose points
+// no longer fit in 64 bits
+auto AoC2023::day4_part1_bitset(SolutionInput input) -> SolutionReturn {
+    static constexpr SolutionReturn MAX_POINTS = std::numeric_limits<SolutionReturn>::max();
+
+    SolutionReturn acc = 0;
+    for (auto const matches : parse_card_matches(input)) {
+        if (matches == 0) {
+            continue;
+        }
+
+        if (matches > std::numeric_limits<SolutionReturn>::digits) {
+            throw std::overflow_error("scratch card points do not fit in 64 bits");
+        }
+
+        SolutionReturn const points = SolutionReturn{1} << (matches - 1);
+        if (acc > MAX_POINTS - points) {
+            throw std::overflow_error("scratch card points do not fit in 64 bits");
         }
+
+        acc += points;
     }
 
-    return std::accumulate(total_scratch_cards.begin(), total_scratch_cards.end(), 0,
-                           [](int acc, std::pair<int, int> card_totals) {
-                               return acc + card_totals.second;
-                           });
+    return acc;
+}
+
+auto AoC2023::day4_part2_bitset(SolutionInput input) -> SolutionReturn {
+    return count_scratch_cards(parse_card_matches(input));
 }
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <bitset>
+#include <span>
+#include <vector>
+
+#include "solution.hpp"
+
+// One bit per number on one side of a card, card numbers are all below 128
+using card_numbers_type = std::bitset<128>;
+
+// Number of winning numbers drawn on each card, in card order
+auto parse_card_matches(SolutionInput scratch_cards_input) -> std::vector<int>;
+
+// Cards held once every card has won one copy of each of the next `matches`
+// cards, throws std::overflow_error past 64 bits
+auto count_scratch_cards(std::span<int const> card_matches) -> SolutionReturn;
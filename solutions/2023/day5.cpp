@@ -1,7 +1,10 @@
 #include <algorithm>
+#include <bit>
 #include <cctype>
 #include <cstdint>
+#include <charconv>
 #include <cmath>
+#include <limits>
 #include <cstdlib>
 #include <numeric>
 #include <stdexcept>
@@ -10,6 +13,7 @@
 #include <array>
 #include <utility>
 #include <list>
+#include <span>
 #include <vector>
 #include <ranges>
 #include <format>
@@ -17,176 +21,10 @@
 
 #include "aoc2023.hpp"
 #include "solution.hpp"
+#include "day5.hpp"
+#include "parallel.hpp"
 
-enum IDChunkType {
-    Single,
-    Pair
-};
-
-struct AlmanacRange {
-    std::int64_t start;
-    std::int64_t length;
-    std::int64_t overlap;
-
-    static auto slices(AlmanacRange lhs, AlmanacRange rhs) -> std::array<AlmanacRange, 3> {
-        std::int64_t lhs_end = lhs.start + lhs.length;
-        std::int64_t rhs_end = rhs.start + rhs.length;
-
-        // |---A---|
-        //     |-x-B---|
-        //       ^
-        //       |______ = (s_A + l_A) - s_B
-        bool inner_right = lhs.start <= rhs.start && rhs.start < lhs_end && lhs_end <= rhs_end;
-
-        //     |---A---|
-        // |---B-x-|
-        //       ^
-        //       |______ = (s_B + l_B) - s_A
-        bool inner_left = rhs.start <= lhs.start && lhs.start < rhs_end && rhs_end <= lhs_end;
-
-        // |---A---|
-        //  |--B--|
-        //     ^
-        //     |________ = l_B
-        bool all_of = lhs.start < rhs.start && rhs_end < lhs_end;
-
-        //  |--A--|
-        // |---B---|
-        //     ^
-        //     |________ = l_A
-        bool some_of = rhs.start < lhs.start && lhs_end < rhs_end;
-
-        //         |--A--|
-        // |---B---|
-        //
-        // OR
-        //
-        // |--A--|
-        //       |---B---|
-        // bool none = lhs.start >= rhs_end || lhs_end <= rhs.start;
-
-
-        // TODO: Better way to express this logic?
-        if (inner_right) {
-            return {
-                AlmanacRange{ lhs.start, rhs.start - lhs.start, 0 },
-                AlmanacRange{ rhs.start, lhs_end - rhs.start, lhs_end - rhs.start },
-                AlmanacRange{ 0, 0, 0 },
-            };
-        } else if (inner_left) {
-            return {
-                AlmanacRange{ 0, 0, 0 },
-                AlmanacRange{ lhs.start, rhs_end - lhs.start, rhs_end - lhs.start },
-                AlmanacRange{ rhs_end, lhs_end - rhs_end, lhs_end - rhs_end }
-            };
-        } else if (all_of) {
-            return {
-                AlmanacRange{ lhs.start, lhs.start - rhs.start, 0 },
-                AlmanacRange{ rhs.start, rhs.length, rhs.length },
-                AlmanacRange{ rhs_end, lhs_end - rhs_end, 0 }
-            };
-        } else if (some_of) {
-            return {
-                AlmanacRange{ 0, 0, 0 },
-                AlmanacRange{ lhs.start, lhs.length, lhs.length },
-                AlmanacRange{ 0, 0, 0 }
-            };
-        }
-
-        return {
-            AlmanacRange{ 0, 0, 0 },
-            AlmanacRange{ lhs.start, lhs.length, 0 },
-            AlmanacRange{ 0, 0, 0 }
-        };
-    }
-};
-
-struct AlmanacEntry {
-    using entry_type = std::pair<AlmanacRange, bool>;
-    entry_type seed;
-    entry_type soil;
-    entry_type fertilizer;
-    entry_type water;
-    entry_type light;
-    entry_type temperature;
-    entry_type humidity;
-    entry_type location;
-
-    AlmanacEntry(AlmanacRange const& seed)
-        : seed({seed, true})
-        , soil({{}, false})
-        , fertilizer({{}, false})
-        , water({{}, false})
-        , light({{}, false})
-        , temperature({{}, false})
-        , humidity({{}, false})
-        , location({{}, false})
-    {}
-
-    explicit AlmanacEntry(AlmanacEntry const& almanac_entry, std::size_t index, std::int64_t length, std::int64_t offset)
-        : seed({{}, false})
-        , soil({{}, false})
-        , fertilizer({{}, false})
-        , water({{}, false})
-        , light({{}, false})
-        , temperature({{}, false})
-        , humidity({{}, false})
-        , location({{}, false})
-    {
-        for (std::size_t j = 0; j <= index; ++j) {
-            this->set(j, { almanac_entry.value(j).start + offset, length, 0 });
-        }
-    }
-
-    auto operator[](std::size_t column) -> entry_type& {
-        switch(column) {
-            case 0: { return this->seed; } break;
-            case 1: { return this->soil; } break;
-            case 2: { return this->fertilizer; } break;
-            case 3: { return this->water; } break;
-            case 4: { return this->light; } break;
-            case 5: { return this->temperature; } break;
-            case 6: { return this->humidity; } break;
-            case 7: { return this->location; } break;
-            default: throw std::out_of_range(std::format("index is out bounds for almanac entry: index {} does not exist", column));
-        }
-    }
-
-    auto at(std::size_t column) const -> entry_type {
-        if (column > 7) {
-            throw std::out_of_range(std::format("index is out bounds for almanac entry: index {} does not exist", column));
-        }
-        return static_cast<entry_type>((*const_cast<AlmanacEntry*>(this))[column]);
-    }
-
-    auto set(std::size_t column, AlmanacRange value) -> void {
-        auto& entry = (*this)[column];
-        entry.first = value;
-        entry.second = true;
-    }
-
-    auto value(std::size_t column) const -> AlmanacRange {
-        return this->at(column).first;
-    }
-
-    auto check(std::size_t column) const -> bool {
-        return this->at(column).second;
-    }
-
-    auto enable_until(std::size_t column) -> void {
-        for (std::size_t i = 0; i < std::min(7uz, column); ++i) {
-            (*this)[i].second = true;
-        }
-    }
-};
-
-struct SourceDestinationRange {
-    std::int64_t destination_start;
-    std::int64_t source_start;
-    std::int64_t range;
-};
-
-auto check_range_bound_and_update_almanac(SourceDestinationRange const& range, std::list<AlmanacEntry>& almanac, std::size_t const index) {
+auto check_range_bound_and_update_almanac(SourceDestinationRange const& range, std::list<AlmanacEntry>& almanac, std::size_t const index) -> void {
     AlmanacRange source { range.source_start, range.range, 0 };
     std::vector<typename std::list<AlmanacEntry>::iterator> invalid_entries{};
 
@@ -202,7 +40,7 @@ auto check_range_bound_and_update_almanac(SourceDestinationRange const& range, s
                 auto split_start = (sub_slice.overlap == 0)
                     ? (!almanac_entry->check(index + 1))
                         ? split_entry.value(index).start
-                        : almanac_entry->value(index + 1).start
+                        : almanac_entry->value(index + 1).start + offset
                     : range.destination_start + (sub_slice.start - source.start);
 
                 split_entry.set(index + 1, { split_start, sub_slice.length, 0 });
@@ -286,7 +124,7 @@ auto parse_range_entry(std::ranges::sized_range auto&& range_chunk) -> SourceDes
     return {};
 }
 
-auto parse_almanac_table(SolutionInput almanac_input, int id_type = IDChunkType::Single) -> std::list<AlmanacEntry> {
+auto parse_almanac_table(SolutionInput almanac_input, int id_type) -> std::list<AlmanacEntry> {
     std::list<AlmanacEntry> almanac{};
 
     auto almanac_sections = almanac_input
@@ -318,11 +156,7 @@ auto AoC2023::day5_part1(SolutionInput input) -> SolutionReturn {
 
     return std::min_element(almanac.begin(), almanac.end(),
                             [](auto const& current, auto const& next) { 
-                               auto current_end = current.location.first.start + current.location.first.length;
-                               auto next_end = next.location.first.start + next.location.first.length;
-
-                                return current.location.first.start < next.location.first.start
-                                    && current_end < next_end;
+                                return current.location.first.start < next.location.first.start;
                             })
         ->location.first.start;
 }
@@ -332,11 +166,395 @@ auto AoC2023::day5_part2(SolutionInput input) -> SolutionReturn {
 
     return std::min_element(almanac.begin(), almanac.end(),
                             [](auto const& current, auto const& next) { 
-                               auto current_end = current.location.first.start + current.location.first.length;
-                               auto next_end = next.location.first.start + next.location.first.length;
-
-                                return current.location.first.start < next.location.first.start
-                                    && current_end < next_end;
+                                return current.location.first.start < next.location.first.start;
                             })
         ->location.first.start;
 }
+
+auto AlmanacMap::from_rows(std::span<SourceDestinationRange const> rows) -> AlmanacMap {
+    std::vector<SourceDestinationRange> sorted_rows{ rows.begin(), rows.end() };
+    std::ranges::sort(sorted_rows, {}, &SourceDestinationRange::source_start);
+
+    AlmanacMap map{};
+    std::int64_t covered = 0;
+    for (auto const& row : sorted_rows) {
+        if (row.range <= 0) {
+            continue;
+        }
+
+        if (row.source_start < covered) {
+            throw std::invalid_argument(std::format("almanac row at {} overlaps the rows before it", row.source_start));
+        }
+
+        if (row.source_start > covered || map.pieces.empty()) {
+            map.pieces.push_back({ covered, 0 });
+        }
+
+        map.pieces.push_back({ row.source_start, row.destination_start - row.source_start });
+        covered = row.source_start + row.range;
+    }
+
+    map.pieces.push_back({ covered, 0 });
+
+    // A row starting at 0 leaves an empty identity piece in front of it
+    if (map.pieces.size() > 1 && map.pieces[0].start == map.pieces[1].start) {
+        map.pieces.erase(map.pieces.begin());
+    }
+
+    return map;
+}
+
+// Every piece of this map is cut wherever its image crosses a piece boundary
+// of `next`, so the composition has at most as many pieces as both maps
+// together
+auto AlmanacMap::then(AlmanacMap const& next) const -> AlmanacMap {
+    AlmanacMap composed{};
+    composed.pieces.reserve(this->pieces.size() + next.pieces.size());
+
+    auto const push_piece = [&composed](AlmanacPiece piece) {
+        if (!composed.pieces.empty() && composed.pieces.back().offset == piece.offset) {
+            return;
+        }
+        composed.pieces.push_back(piece);
+    };
+
+    for (std::size_t i = 0; i < this->pieces.size(); ++i) {
+        auto const [start, offset] = this->pieces[i];
+        std::int64_t const image_end = this->piece_end(i) + offset;
+
+        auto j = static_cast<std::size_t>(std::ranges::upper_bound(next.pieces, start + offset, {}, &AlmanacPiece::start) - next.pieces.begin()) - 1;
+        push_piece({ start, offset + next.pieces[j].offset });
+
+        for (++j; j < next.pieces.size() && next.pieces[j].start < image_end; ++j) {
+            push_piece({ next.pieces[j].start - offset, offset + next.pieces[j].offset });
+        }
+    }
+
+    return composed;
+}
+
+auto AlmanacMap::operator()(std::int64_t id) const -> std::int64_t {
+    auto const piece = std::ranges::upper_bound(this->pieces, id, {}, &AlmanacPiece::start) - 1;
+    return id + piece->offset;
+}
+
+// Images grow with the id inside a piece, so only the first id of every
+// piece the range touches is a candidate
+auto AlmanacMap::min_image(AlmanacRange range) const -> std::int64_t {
+    auto const range_end = range.start + range.length;
+    auto piece = std::ranges::upper_bound(this->pieces, range.start, {}, &AlmanacPiece::start) - 1;
+
+    std::int64_t image = range.start + piece->offset;
+    for (++piece; piece != this->pieces.end() && piece->start < range_end; ++piece) {
+        image = std::min(image, piece->start + piece->offset);
+    }
+
+    return image;
+}
+
+auto AlmanacMap::image_ranges(AlmanacRange range, std::vector<AlmanacRange>& images) const -> void {
+    auto const range_end = range.start + range.length;
+    auto piece = static_cast<std::size_t>(std::ranges::upper_bound(this->pieces, range.start, {}, &AlmanacPiece::start) - this->pieces.begin()) - 1;
+
+    for (; piece < this->pieces.size() && this->pieces[piece].start < range_end; ++piece) {
+        std::int64_t const start = std::max(range.start, this->pieces[piece].start);
+        std::int64_t const end = std::min(range_end, this->piece_end(piece));
+        images.push_back({ start + this->pieces[piece].offset, end - start, 0 });
+    }
+}
+
+static auto parse_almanac_numbers(std::string_view line) -> std::vector<std::int64_t> {
+    std::vector<std::int64_t> numbers{};
+    char const* cursor = line.data();
+    char const* const end = line.data() + line.size();
+
+    while (cursor != end) {
+        if (*cursor < '0' || *cursor > '9') {
+            ++cursor;
+            continue;
+        }
+
+        std::int64_t number = 0;
+        auto const [next, error] = std::from_chars(cursor, end, number);
+        if (error != std::errc{} || number >= ALMANAC_ID_END) {
+            throw std::out_of_range(std::format("almanac number out of range: {}", std::string_view{ cursor, end }));
+        }
+
+        numbers.push_back(number);
+        cursor = next;
+    }
+
+    return numbers;
+}
+
+auto CompiledAlmanac::parse(SolutionInput almanac_input, int id_type) -> CompiledAlmanac {
+    CompiledAlmanac almanac{};
+
+    auto const seed_numbers = parse_almanac_numbers(almanac_input.at(0));
+    if (id_type == IDChunkType::Single) {
+        for (auto const seed : seed_numbers) {
+            almanac.seeds.push_back({ seed, 1, 0 });
+        }
+    } else {
+        for (std::size_t i = 0; i + 1 < seed_numbers.size(); i += 2) {
+            almanac.seeds.push_back({ seed_numbers[i], seed_numbers[i + 1], 0 });
+        }
+    }
+
+    std::size_t section = 0;
+    std::vector<SourceDestinationRange> rows{};
+    for (auto line = almanac_input.begin() + 1; line != almanac_input.end(); ++line) {
+        if (line->empty()) {
+            continue;
+        }
+
+        if (line->ends_with("map:")) {
+            if (section > 0) {
+                almanac.sections.at(section - 1) = AlmanacMap::from_rows(rows);
+            }
+            rows.clear();
+            ++section;
+            continue;
+        }
+
+        auto const values = parse_almanac_numbers(*line);
+        rows.push_back({ values.at(0), values.at(1), values.at(2) });
+    }
+
+    if (section > 0) {
+        almanac.sections.at(section - 1) = AlmanacMap::from_rows(rows);
+    }
+
+    for (auto& map : almanac.sections | std::views::drop(section)) {
+        map = AlmanacMap::from_rows({});
+    }
+
+    almanac.seed_to_location = almanac.sections[0];
+    for (auto const& map : almanac.sections | std::views::drop(1)) {
+        almanac.seed_to_location = almanac.seed_to_location.then(map);
+    }
+
+    return almanac;
+}
+
+auto CompiledAlmanac::min_location() const -> std::int64_t {
+    std::int64_t location = std::numeric_limits<std::int64_t>::max();
+    bool found = false;
+
+    for (auto const& range : this->seeds) {
+        if (range.length > 0) {
+            location = std::min(location, this->seed_to_location.min_image(range));
+            found = true;
+        }
+    }
+
+    if (!found) {
+        throw std::out_of_range("almanac holds no seeds");
+    }
+
+    return location;
+}
+
+auto AlmanacLookup::from_map(AlmanacMap const& map) -> AlmanacLookup {
+    AlmanacLookup lookup{};
+    lookup.levels = std::bit_width(map.pieces.size());
+
+    // Padding keys sort after every real key and are never the first key
+    // above an id, the real last key is ALMANAC_ID_END
+    std::size_t const nodes = (std::size_t{1} << lookup.levels) - 1;
+    lookup.keys.assign(nodes + 1, std::numeric_limits<std::int64_t>::max());
+    lookup.offsets.assign(nodes + 1, 0);
+
+    // Node k at depth d of a complete tree holds the in-order element
+    // (2 (k - 2^d) + 1) 2^(levels - 1 - d) - 1
+    for (std::size_t node = 1; node <= nodes; ++node) {
+        std::size_t const depth = std::bit_width(node) - 1;
+        std::size_t const sorted = ((2 * (node - (std::size_t{1} << depth)) + 1) << (lookup.levels - 1 - depth)) - 1;
+
+        if (sorted < map.pieces.size()) {
+            lookup.keys[node] = map.piece_end(sorted);
+            lookup.offsets[node] = map.pieces[sorted].offset;
+        }
+    }
+
+    return lookup;
+}
+
+auto AlmanacLookup::operator()(std::int64_t id) const -> std::int64_t {
+    std::size_t node = 1;
+    for (std::size_t level = 0; level < this->levels; ++level) {
+        node = 2 * node + static_cast<std::size_t>(this->keys[node] <= id);
+    }
+
+    node >>= std::countr_one(node) + 1;
+    return id + this->offsets[node];
+}
+
+auto AlmanacLookup::translate(std::span<std::int64_t const> ids, std::span<std::int64_t> images) const -> void {
+    std::size_t i = 0;
+    for (; i + BATCH_LANES <= ids.size(); i += BATCH_LANES) {
+        std::array<std::size_t, BATCH_LANES> nodes{};
+        nodes.fill(1);
+
+        for (std::size_t level = 0; level < this->levels; ++level) {
+            for (std::size_t lane = 0; lane < BATCH_LANES; ++lane) {
+                nodes[lane] = 2 * nodes[lane] + static_cast<std::size_t>(this->keys[nodes[lane]] <= ids[i + lane]);
+            }
+        }
+
+        for (std::size_t lane = 0; lane < BATCH_LANES; ++lane) {
+            images[i + lane] = ids[i + lane] + this->offsets[nodes[lane] >> (std::countr_one(nodes[lane]) + 1)];
+        }
+    }
+
+    for (; i < ids.size(); ++i) {
+        images[i] = (*this)(ids[i]);
+    }
+}
+
+auto AlmanacLookup::translate(std::span<std::int64_t const> ids) const -> std::vector<std::int64_t> {
+    std::vector<std::int64_t> images(ids.size());
+    this->translate(ids, images);
+    return images;
+}
+
+auto merge_almanac_ranges(std::vector<AlmanacRange> ranges) -> std::vector<AlmanacRange> {
+    std::erase_if(ranges, [](AlmanacRange const& range) { return range.length <= 0; });
+    std::ranges::sort(ranges, {}, &AlmanacRange::start);
+
+    std::vector<AlmanacRange> merged{};
+    for (auto const& range : ranges) {
+        if (!merged.empty() && range.start <= merged.back().start + merged.back().length) {
+            auto& last = merged.back();
+            last.length = std::max(last.length, range.start + range.length - last.start);
+        } else {
+            merged.push_back({ range.start, range.length, 0 });
+        }
+    }
+
+    return merged;
+}
+
+auto AlmanacPreimages::from_map(AlmanacMap const& map) -> AlmanacPreimages {
+    AlmanacPreimages preimages{};
+    preimages.pieces.reserve(map.pieces.size());
+
+    for (std::size_t i = 0; i < map.pieces.size(); ++i) {
+        preimages.pieces.push_back({ map.pieces[i].start + map.pieces[i].offset, map.pieces[i].start, map.piece_end(i) });
+    }
+
+    std::ranges::sort(preimages.pieces, {}, &Preimage::image_start);
+    return preimages;
+}
+
+// Images only grow inside a piece, so the best image a piece can offer is
+// that of its first id inside the ranges, and once that beats the image
+// start of the next piece no later piece can do better
+auto AlmanacPreimages::min_image(std::span<AlmanacRange const> ranges) const -> std::optional<std::int64_t> {
+    std::optional<std::int64_t> best{};
+
+    for (auto const& piece : this->pieces) {
+        if (best && *best <= piece.image_start) {
+            break;
+        }
+
+        auto const range = std::ranges::lower_bound(ranges, piece.start, {}, [](AlmanacRange const& r) { return r.start + r.length - 1; });
+        if (range == ranges.end() || range->start >= piece.end) {
+            continue;
+        }
+
+        std::int64_t const image = piece.image_start + (std::max(range->start, piece.start) - piece.start);
+        best = best ? std::min(*best, image) : image;
+    }
+
+    return best;
+}
+
+static constexpr std::size_t SEED_RANGE_CHUNK = 256;
+
+// Every chunk of seed ranges is split through the sections on its own, so
+// the workers share nothing but their slot in the minima
+auto CompiledAlmanac::min_location_parallel(std::size_t max_threads) const -> std::int64_t {
+    static constexpr std::int64_t NO_LOCATION = std::numeric_limits<std::int64_t>::max();
+
+    std::size_t const chunks = (this->seeds.size() + SEED_RANGE_CHUNK - 1) / SEED_RANGE_CHUNK;
+    std::vector<std::int64_t> chunk_minima(chunks, NO_LOCATION);
+
+    parallel::for_each_index(chunks, [&](std::size_t chunk) {
+        std::vector<AlmanacRange> ranges{};
+        std::vector<AlmanacRange> images{};
+        std::int64_t location = NO_LOCATION;
+
+        auto const first = this->seeds.begin() + chunk * SEED_RANGE_CHUNK;
+        auto const last = this->seeds.begin() + std::min(this->seeds.size(), (chunk + 1) * SEED_RANGE_CHUNK);
+        for (auto seed = first; seed != last; ++seed) {
+            if (seed->length <= 0) {
+                continue;
+            }
+
+            ranges.assign(1, *seed);
+            for (auto const& section : this->sections) {
+                images.clear();
+                for (auto const& range : ranges) {
+                    section.image_ranges(range, images);
+                }
+                std::swap(ranges, images);
+            }
+
+            for (auto const& range : ranges) {
+                location = std::min(location, range.start);
+            }
+        }
+
+        chunk_minima[chunk] = location;
+    }, max_threads);
+
+    auto const location = std::ranges::min_element(chunk_minima);
+    if (location == chunk_minima.end() || *location == NO_LOCATION) {
+        throw std::out_of_range("almanac holds no seeds");
+    }
+
+    return *location;
+}
+
+auto AoC2023::day5_part1_composed(SolutionInput input) -> SolutionReturn {
+    return CompiledAlmanac::parse(input, IDChunkType::Single).min_location();
+}
+
+auto AoC2023::day5_part2_composed(SolutionInput input) -> SolutionReturn {
+    return CompiledAlmanac::parse(input, IDChunkType::Pair).min_location();
+}
+
+auto AoC2023::day5_part1_lookup(SolutionInput input) -> SolutionReturn {
+    auto const almanac = CompiledAlmanac::parse(input, IDChunkType::Single);
+    auto const lookup = AlmanacLookup::from_map(almanac.seed_to_location);
+
+    std::vector<std::int64_t> seeds{};
+    seeds.reserve(almanac.seeds.size());
+    for (auto const& seed : almanac.seeds) {
+        seeds.push_back(seed.start);
+    }
+
+    auto const locations = lookup.translate(seeds);
+    if (locations.empty()) {
+        throw std::out_of_range("almanac holds no seeds");
+    }
+
+    return std::ranges::min(locations);
+}
+
+auto AoC2023::day5_part2_reverse(SolutionInput input) -> SolutionReturn {
+    auto const almanac = CompiledAlmanac::parse(input, IDChunkType::Pair);
+    auto const seeds = merge_almanac_ranges(almanac.seeds);
+    auto const location = AlmanacPreimages::from_map(almanac.seed_to_location).min_image(seeds);
+
+    if (!location) {
+        throw std::out_of_range("almanac holds no seeds");
+    }
+
+    return *location;
+}
+
+auto AoC2023::day5_part2_parallel(SolutionInput input) -> SolutionReturn {
+    return CompiledAlmanac::parse(input, IDChunkType::Pair).min_location_parallel(parallel::concurrency());
+}
@@ -0,0 +1,278 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <format>
+#include <list>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "solution.hpp"
+
+enum IDChunkType {
+    Single,
+    Pair
+};
+
+struct AlmanacRange {
+    std::int64_t start;
+    std::int64_t length;
+    std::int64_t overlap;
+
+    static auto slices(AlmanacRange lhs, AlmanacRange rhs) -> std::array<AlmanacRange, 3> {
+        std::int64_t lhs_end = lhs.start + lhs.length;
+        std::int64_t rhs_end = rhs.start + rhs.length;
+
+        // |---A---|
+        //     |-x-B---|
+        //       ^
+        //       |______ = (s_A + l_A) - s_B
+        bool inner_right = lhs.start <= rhs.start && rhs.start < lhs_end && lhs_end <= rhs_end;
+
+        //     |---A---|
+        // |---B-x-|
+        //       ^
+        //       |______ = (s_B + l_B) - s_A
+        bool inner_left = rhs.start <= lhs.start && lhs.start < rhs_end && rhs_end <= lhs_end;
+
+        // |---A---|
+        //  |--B--|
+        //     ^
+        //     |________ = l_B
+        bool all_of = lhs.start < rhs.start && rhs_end < lhs_end;
+
+        //  |--A--|
+        // |---B---|
+        //     ^
+        //     |________ = l_A
+        bool some_of = rhs.start < lhs.start && lhs_end < rhs_end;
+
+        //         |--A--|
+        // |---B---|
+        //
+        // OR
+        //
+        // |--A--|
+        //       |---B---|
+        // bool none = lhs.start >= rhs_end || lhs_end <= rhs.start;
+
+
+        // TODO: Better way to express this logic?
+        if (inner_right) {
+            return {
+                AlmanacRange{ lhs.start, rhs.start - lhs.start, 0 },
+                AlmanacRange{ rhs.start, lhs_end - rhs.start, lhs_end - rhs.start },
+                AlmanacRange{ 0, 0, 0 },
+            };
+        } else if (inner_left) {
+            return {
+                AlmanacRange{ 0, 0, 0 },
+                AlmanacRange{ lhs.start, rhs_end - lhs.start, rhs_end - lhs.start },
+                AlmanacRange{ rhs_end, lhs_end - rhs_end, 0 }
+            };
+        } else if (all_of) {
+            return {
+                AlmanacRange{ lhs.start, rhs.start - lhs.start, 0 },
+                AlmanacRange{ rhs.start, rhs.length, rhs.length },
+                AlmanacRange{ rhs_end, lhs_end - rhs_end, 0 }
+            };
+        } else if (some_of) {
+            return {
+                AlmanacRange{ 0, 0, 0 },
+                AlmanacRange{ lhs.start, lhs.length, lhs.length },
+                AlmanacRange{ 0, 0, 0 }
+            };
+        }
+
+        return {
+            AlmanacRange{ 0, 0, 0 },
+            AlmanacRange{ lhs.start, lhs.length, 0 },
+            AlmanacRange{ 0, 0, 0 }
+        };
+    }
+};
+
+struct AlmanacEntry {
+    using entry_type = std::pair<AlmanacRange, bool>;
+    entry_type seed;
+    entry_type soil;
+    entry_type fertilizer;
+    entry_type water;
+    entry_type light;
+    entry_type temperature;
+    entry_type humidity;
+    entry_type location;
+
+    AlmanacEntry(AlmanacRange const& seed)
+        : seed({seed, true})
+        , soil({{}, false})
+        , fertilizer({{}, false})
+        , water({{}, false})
+        , light({{}, false})
+        , temperature({{}, false})
+        , humidity({{}, false})
+        , location({{}, false})
+    {}
+
+    explicit AlmanacEntry(AlmanacEntry const& almanac_entry, std::size_t index, std::int64_t length, std::int64_t offset)
+        : seed({{}, false})
+        , soil({{}, false})
+        , fertilizer({{}, false})
+        , water({{}, false})
+        , light({{}, false})
+        , temperature({{}, false})
+        , humidity({{}, false})
+        , location({{}, false})
+    {
+        for (std::size_t j = 0; j <= index; ++j) {
+            this->set(j, { almanac_entry.value(j).start + offset, length, 0 });
+        }
+    }
+
+    auto operator[](std::size_t column) -> entry_type& {
+        switch(column) {
+            case 0: { return this->seed; } break;
+            case 1: { return this->soil; } break;
+            case 2: { return this->fertilizer; } break;
+            case 3: { return this->water; } break;
+            case 4: { return this->light; } break;
+            case 5: { return this->temperature; } break;
+            case 6: { return this->humidity; } break;
+            case 7: { return this->location; } break;
+            default: throw std::out_of_range(std::format("index is out bounds for almanac entry: index {} does not exist", column));
+        }
+    }
+
+    auto at(std::size_t column) const -> entry_type {
+        if (column > 7) {
+            throw std::out_of_range(std::format("index is out bounds for almanac entry: index {} does not exist", column));
+        }
+        return static_cast<entry_type>((*const_cast<AlmanacEntry*>(this))[column]);
+    }
+
+    auto set(std::size_t column, AlmanacRange value) -> void {
+        auto& entry = (*this)[column];
+        entry.first = value;
+        entry.second = true;
+    }
+
+    auto value(std::size_t column) const -> AlmanacRange {
+        return this->at(column).first;
+    }
+
+    auto check(std::size_t column) const -> bool {
+        return this->at(column).second;
+    }
+
+    auto enable_until(std::size_t column) -> void {
+        for (std::size_t i = 0; i < std::min(7uz, column); ++i) {
+            (*this)[i].second = true;
+        }
+    }
+};
+
+struct SourceDestinationRange {
+    std::int64_t destination_start;
+    std::int64_t source_start;
+    std::int64_t range;
+};
+
+auto check_range_bound_and_update_almanac(SourceDestinationRange const& range, std::list<AlmanacEntry>& almanac, std::size_t const index) -> void;
+auto parse_almanac_table(SolutionInput almanac_input, int id_type = IDChunkType::Single) -> std::list<AlmanacEntry>;
+
+// Ids are non-negative and stay below this bound, so that every piece has an
+// end and shifting it by any row offset cannot overflow
+static constexpr std::int64_t ALMANAC_ID_END = std::int64_t{1} << 62;
+
+// Ids from start up to the start of the next piece map to id + offset
+struct AlmanacPiece {
+    std::int64_t start;
+    std::int64_t offset;
+};
+
+// One almanac section, or a composition of several, as a total function on
+// [0, ALMANAC_ID_END). Pieces are sorted, the first starts at 0 and the gaps
+// between rows are pieces with offset 0.
+struct AlmanacMap {
+    std::vector<AlmanacPiece> pieces;
+
+    // Throws std::invalid_argument on overlapping source ranges
+    static auto from_rows(std::span<SourceDestinationRange const> rows) -> AlmanacMap;
+
+    // This map followed by `next`
+    auto then(AlmanacMap const& next) const -> AlmanacMap;
+
+    auto operator()(std::int64_t id) const -> std::int64_t;
+
+    // Smallest image of the ids in [range.start, range.start + range.length)
+    auto min_image(AlmanacRange range) const -> std::int64_t;
+
+    // Appends the images of the ids in the range, one range per piece touched
+    auto image_ranges(AlmanacRange range, std::vector<AlmanacRange>& images) const -> void;
+
+    auto piece_end(std::size_t piece) const -> std::int64_t {
+        return (piece + 1 < this->pieces.size()) ? this->pieces[piece + 1].start : ALMANAC_ID_END;
+    }
+};
+
+// An AlmanacMap laid out for point queries. Keys are the piece ends in
+// Eytzinger (breadth first) order, padded to a complete tree, and every key
+// carries the offset of the piece it ends. A query walks all levels of the
+// tree branch free and lands on the first piece end above the id.
+struct AlmanacLookup {
+    static constexpr std::size_t BATCH_LANES = 8;
+
+    std::vector<std::int64_t> keys;
+    std::vector<std::int64_t> offsets;
+    std::size_t levels;
+
+    static auto from_map(AlmanacMap const& map) -> AlmanacLookup;
+
+    auto operator()(std::int64_t id) const -> std::int64_t;
+
+    // ids[i] mapped into images[i], BATCH_LANES searches run interleaved
+    auto translate(std::span<std::int64_t const> ids, std::span<std::int64_t> images) const -> void;
+    auto translate(std::span<std::int64_t const> ids) const -> std::vector<std::int64_t>;
+};
+
+// The pieces of an AlmanacMap ordered by their images. Sections are not
+// injective, so several pieces may share images, but walking images upwards
+// still finds the smallest image of a set of ids without mapping the ids.
+struct AlmanacPreimages {
+    struct Preimage {
+        std::int64_t image_start;
+        std::int64_t start;
+        std::int64_t end;
+    };
+
+    std::vector<Preimage> pieces;
+
+    static auto from_map(AlmanacMap const& map) -> AlmanacPreimages;
+
+    // Smallest image of any id in the ranges, which must be sorted and
+    // disjoint, nothing if the ranges hold no ids
+    auto min_image(std::span<AlmanacRange const> ranges) const -> std::optional<std::int64_t>;
+};
+
+// Sorted, disjoint and non-empty ranges covering the same ids
+auto merge_almanac_ranges(std::vector<AlmanacRange> ranges) -> std::vector<AlmanacRange>;
+
+// The seven sections of an almanac and their composition into a single
+// seed to location map
+struct CompiledAlmanac {
+    std::vector<AlmanacRange> seeds;
+    std::array<AlmanacMap, 7> sections;
+    AlmanacMap seed_to_location;
+
+    static auto parse(SolutionInput almanac_input, int id_type) -> CompiledAlmanac;
+
+    // Smallest location of any seed
+    auto min_location() const -> std::int64_t;
+
+    // Smallest location of any seed, with chunks of seed ranges pushed
+    // through the seven sections on up to max_threads threads
+    auto min_location_parallel(std::size_t max_threads) const -> std::int64_t;
+};
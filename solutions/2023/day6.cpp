@@ -1,7 +1,9 @@
 #include <algorithm>
 #include <cctype>
+#include <charconv>
 #include <cstdint>
 #include <cmath>
+#include <limits>
 #include <cstdlib>
 #include <functional>
 #include <iterator>
@@ -11,7 +13,7 @@
 #include <string_view>
 #include <array>
 #include <utility>
-#include <map>
+#include <span>
 #include <vector>
 #include <ranges>
 #include <format>
@@ -19,9 +21,10 @@
 
 #include "aoc2023.hpp"
 #include "solution.hpp"
+#include "day6.hpp"
 
-auto parse_race_records(SolutionInput race_table) -> std::map<int, int> {
-    std::map<int, int> race_records{};
+auto parse_race_records(SolutionInput race_table) -> std::vector<std::pair<int, int>> {
+    std::vector<std::pair<int, int>> race_records{};
 
     auto parsed_records = race_table
         | std::views::transform([](auto const& row) {
@@ -41,7 +44,7 @@ auto parse_race_records(SolutionInput race_table) -> std::map<int, int> {
             });
 
     for (auto const [i, value] : parsed_records.front() | std::views::enumerate) {
-        race_records[value] = parsed_records.back().at(i);
+        race_records.emplace_back(value, parsed_records.back().at(i));
     }
 
     return race_records;
@@ -70,7 +73,7 @@ auto AoC2023::day6_part1(SolutionInput input) -> SolutionReturn {
     auto const race_records = parse_race_records(input);
     std::vector<int> winning_durations{};
 
-    for (auto const [time, record] : race_records) {
+    for (auto const& [time, record] : race_records) {
         int win_count = 0;
         for (int t = 0; t < time; ++t) {
             int duration = (time - t) * t;
@@ -87,21 +90,179 @@ auto AoC2023::day6_part1(SolutionInput input) -> SolutionReturn {
 auto AoC2023::day6_part2(SolutionInput input) -> SolutionReturn {
     auto const [time, record] = parse_race_records_ignore_kerning(input);
 
-    std::int64_t t = time / 2;
-    std::int64_t offset = time - t;
-    std::int64_t minimum = t;
-    std::int64_t maximum = 0;
+    // Bisect for the largest winning hold, the winning holds are symmetric
+    // around time / 2 where the best hold is
+    std::int64_t minimum = time / 2;
+    std::int64_t maximum = time;
 
-    while (offset != 0) {
-        std::int64_t duration = (time - t) * t;
+    if ((time - minimum) * minimum <= record) {
+        return 0;
+    }
+
+    while (maximum - minimum > 1) {
+        std::int64_t const t = minimum + (maximum - minimum) / 2;
+        std::int64_t const duration = (time - t) * t;
+        ((duration > record) ? minimum : maximum) = t;
+    }
+
+    return 2 * minimum - time + 1;
+}
 
-        if (duration > record) {
-            maximum = std::max(t, maximum);
+auto RaceRecord::wins(std::int64_t hold) const -> bool {
+    return static_cast<race_wide_type>(hold) * (this->time - hold) > this->record;
+}
+
+static auto parse_race_row(std::string_view row) -> std::vector<std::int64_t> {
+    std::vector<std::int64_t> values{};
+    auto const* cursor = row.data() + row.find(':') + 1;
+    auto const* const end = row.data() + row.size();
+
+    while (cursor != end) {
+        if (*cursor == ' ') {
+            ++cursor;
+            continue;
         }
 
-        offset /= 2;
-        t += (duration > record) ? offset : -offset;
+        std::int64_t value = 0;
+        auto const [next, error] = std::from_chars(cursor, end, value);
+        if (error != std::errc{}) {
+            throw std::invalid_argument(std::format("malformed race table row: {}", row));
+        }
+
+        values.push_back(value);
+        cursor = next;
+    }
+
+    return values;
+}
+
+auto parse_race_table(SolutionInput race_table) -> std::vector<RaceRecord> {
+    if (race_table.size() < 2) {
+        throw std::invalid_argument("race table needs a time and a distance row");
+    }
+
+    auto const times = parse_race_row(race_table.front());
+    auto const records = parse_race_row(race_table.at(1));
+    if (times.size() != records.size()) {
+        throw std::invalid_argument("race table rows differ in length");
     }
 
-    return (maximum - minimum) * 2 + ((time % 2 == 0) ? 1 : 0);
+    std::vector<RaceRecord> races(times.size());
+    for (std::size_t i = 0; i < races.size(); ++i) {
+        races[i] = { times[i], records[i] };
+    }
+
+    return races;
+}
+
+auto parse_kerned_race(SolutionInput race_table) -> RaceRecord {
+    if (race_table.size() < 2) {
+        throw std::invalid_argument("race table needs a time and a distance row");
+    }
+
+    auto const kerned_value = [](std::string_view row) {
+        std::int64_t value = 0;
+        for (char const c : row.substr(row.find(':') + 1)) {
+            if (c == ' ') {
+                continue;
+            }
+
+            if (!std::isdigit(c)) {
+                throw std::invalid_argument(std::format("malformed race table row: {}", row));
+            }
+
+            if (value > (std::numeric_limits<std::int64_t>::max() - (c - '0')) / 10) {
+                throw std::overflow_error("kerned race value does not fit in 64 bits");
+            }
+
+            value = value * 10 + (c - '0');
+        }
+
+        return value;
+    };
+
+    return { kerned_value(race_table.front()), kerned_value(race_table.at(1)) };
+}
+
+static auto isqrt(race_wide_type n) -> race_wide_type {
+    race_wide_type root = static_cast<race_wide_type>(std::sqrt(static_cast<long double>(n)));
+    if (root > 0) {
+        root = (root + n / root) / 2;
+    }
+
+    while (root * root > n) {
+        --root;
+    }
+
+    while ((root + 1) * (root + 1) <= n) {
+        ++root;
+    }
+
+    return root;
+}
+
+// The winning holds are the integers strictly between the roots of
+// hold^2 - time * hold + record, which are symmetric around time / 2
+auto count_winning_holds(RaceRecord race) -> std::int64_t {
+    if (race.time < 0 || race.record < 0) {
+        throw std::invalid_argument("race time and record must not be negative");
+    }
+
+    race_wide_type const discriminant = static_cast<race_wide_type>(race.time) * race.time - race_wide_type{4} * race.record;
+    if (discriminant <= 0) {
+        return 0;
+    }
+
+    // (time - isqrt) / 2 is at most one below the first winning hold
+    auto hold = static_cast<std::int64_t>((race.time - isqrt(discriminant)) / 2);
+    while (hold <= race.time / 2 && !race.wins(hold)) {
+        ++hold;
+    }
+
+    while (hold > 0 && race.wins(hold - 1)) {
+        --hold;
+    }
+
+    return (hold <= race.time / 2 && race.wins(hold)) ? race.time - 2 * hold + 1 : 0;
+}
+
+auto count_winning_holds(std::span<RaceRecord const> races, std::span<std::int64_t> counts) -> void {
+    if (counts.size() < races.size()) {
+        throw std::invalid_argument("fewer counts than races");
+    }
+
+    // Branch free estimate of the first winning hold of every race
+    for (std::size_t i = 0; i < races.size(); ++i) {
+        double const time = static_cast<double>(races[i].time);
+        double const discriminant = std::max(0.0, time * time - 4.0 * static_cast<double>(races[i].record));
+        counts[i] = static_cast<std::int64_t>((time - std::sqrt(discriminant)) * 0.5) + 1;
+    }
+
+    for (std::size_t i = 0; i < races.size(); ++i) {
+        auto const& race = races[i];
+        auto const hold = counts[i];
+        bool const exact = race.time >= 0 && race.record >= 0
+            && 2 * hold <= race.time && race.wins(hold) && !race.wins(hold - 1);
+
+        counts[i] = (exact) ? race.time - 2 * hold + 1 : count_winning_holds(race);
+    }
+}
+
+auto AoC2023::day6_part1_closed_form(SolutionInput input) -> SolutionReturn {
+    auto const races = parse_race_table(input);
+    std::vector<std::int64_t> counts(races.size());
+    count_winning_holds(races, counts);
+
+    SolutionReturn product = 1;
+    for (auto const count : counts) {
+        if (__builtin_mul_overflow(product, count, &product)) {
+            throw std::overflow_error("product of winning holds does not fit in 64 bits");
+        }
+    }
+
+    return product;
+}
+
+auto AoC2023::day6_part2_closed_form(SolutionInput input) -> SolutionReturn {
+    return count_winning_holds(parse_kerned_race(input));
 }
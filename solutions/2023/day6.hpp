@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "solution.hpp"
+
+// Race times can be large enough for time * time to overflow 64 bits
+__extension__ using race_wide_type = __int128;
+
+struct RaceRecord {
+    std::int64_t time;
+    std::int64_t record;
+
+    // Whether holding the button for `hold` beats the record
+    auto wins(std::int64_t hold) const -> bool;
+};
+
+// One record per column of the race table
+auto parse_race_table(SolutionInput race_table) -> std::vector<RaceRecord>;
+
+// The race table read as a single race with the spaces removed
+auto parse_kerned_race(SolutionInput race_table) -> RaceRecord;
+
+// Number of hold times that beat the record, solved from the roots of
+// hold * (time - hold) = record, throws std::invalid_argument on negatives
+auto count_winning_holds(RaceRecord race) -> std::int64_t;
+
+// Batch form of count_winning_holds, the roots of every race are estimated in
+// double precision first and only races whose estimate is off are re-solved
+// exactly
+auto count_winning_holds(std::span<RaceRecord const> races, std::span<std::int64_t> counts) -> void;
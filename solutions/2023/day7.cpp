@@ -1,14 +1,16 @@
 #include <algorithm>
 #include <cctype>
+#include <charconv>
 #include <cstdint>
 #include <cmath>
 #include <cstdlib>
 #include <numeric>
+#include <span>
+#include <stdexcept>
 #include <string>
 #include <string_view>
 #include <array>
 #include <utility>
-#include <unordered_map>
 #include <vector>
 #include <ranges>
 #include <format>
@@ -16,316 +18,309 @@
 
 #include "aoc2023.hpp"
 #include "solution.hpp"
+#include "day7.hpp"
+#include "parallel.hpp"
 
-enum Card : int {
-    Two = '2',
-    Three = '3',
-    Four = '4',
-    Five = '5',
-    Six = '6',
-    Seven = '7',
-    Eight = '8',
-    Nine = '9',
-    Ten = 'T',
-    Jack = 'J',
-    Queen = 'Q',
-    King = 'K',
-    Ace = 'A'
-};
+template<JokerRule Rule>
+auto parse_game_hands(SolutionInput game_hands) -> std::vector<Hand<Rule>> {
+    std::vector<Hand<Rule>> hands{};
 
-enum HandType : int {
-    None = 0,
-    HighCard,
-    OnePair,
-    TwoPair,
-    ThreeOfAKind,
-    FullHouse,
-    FourOfAKind,
-    FiveOfAKind
-};
+    auto parsed_hands = game_hands
+        | std::views::transform([](auto game_hand) {
+                auto hand_bid_parts = game_hand
+                    | std::views::split(' ');
 
-struct Hand {
-    using cards_type = std::array<Card, 5>;
-    using verifier_type = std::vector<bool(*)(cards_type const&)>;
+                std::string_view cards{};
+                int bid = 0;
+                for (auto const [i, part] : hand_bid_parts | std::views::enumerate)  {
+                    std::string_view value{part};
+                    if (i == 0) {
+                        cards = value;
+                    } else if (i == 1) {
+                        bid = std::stol(std::string{value.begin(), value.end()});
+                    }
+                }
 
-    cards_type cards;
-    int bid;
-    HandType hand;
+                return Hand<Rule> {
+                    cards,
+                    bid
+                };
+            });
 
-    Hand() = default;
+    std::ranges::copy(parsed_hands.begin(), parsed_hands.end(), std::back_inserter(hands));
 
-    Hand(std::string_view cards, int bid)
-        : cards(Hand::fill_cards(cards, this->cards))
-        , bid(bid)
-        , hand(Hand::compute_hand(*this))
-    {
-    }
+    return hands;
+}
 
-    static const verifier_type verifiers;
-    static bool enable_joker;
+template auto parse_game_hands<JokerRule::Disabled>(SolutionInput game_hands) -> std::vector<Hand<JokerRule::Disabled>>;
+template auto parse_game_hands<JokerRule::Enabled>(SolutionInput game_hands) -> std::vector<Hand<JokerRule::Enabled>>;
 
-    static auto compute_hand(Hand const& hand_in) -> HandType {
-        for (auto const [i, verify] : Hand::verifiers | std::views::reverse | std::views::enumerate) {
-            if (verify(hand_in.cards)) {
-                return static_cast<HandType>(i + 2);
-            }
-        }
+auto AoC2023::day7_part1(SolutionInput input) -> SolutionReturn {
+    auto game_hands = parse_game_hands<JokerRule::Disabled>(input);
+    std::stable_sort(game_hands.begin(), game_hands.end());
 
-        return HandType::HighCard;
+    SolutionReturn total_winnings = 0;
+    for (auto const& [i, hand] : game_hands | std::views::enumerate) {
+        total_winnings += hand.bid * (i + 1);
     }
 
-    static auto to_sequence_value(Card card) -> int {
-        switch (card) {
-            case Card::Two:   { return 0; } break;
-            case Card::Three: { return 1; } break;
-            case Card::Four:  { return 2; } break;
-            case Card::Five:  { return 3; } break;
-            case Card::Six:   { return 4; } break;
-            case Card::Seven: { return 5; } break;
-            case Card::Eight: { return 6; } break;
-            case Card::Nine:  { return 7; } break;
-            case Card::Ten:   { return 8; } break;
-            case Card::Jack:  { return (Hand::enable_joker) ? -1 : 9; } break;
-            case Card::Queen: { return 10; } break;
-            case Card::King:  { return 11; } break;
-            case Card::Ace:   { return 12; } break;
-            default: return -1; // UNREACHABLE
-        }
-
-        // UNREACHABLE
-        return -1;
-    }
+    return total_winnings;
+}
 
-    static auto check_joker_and_modify(std::unordered_map<Card, int>& cards_map) -> void {
-        bool contains_joker = std::find_if(cards_map.begin(), cards_map.end(),
-                                           [](auto const& entry) { return entry.first == Card::Jack; }) != cards_map.end();
+auto AoC2023::day7_part2(SolutionInput input) -> SolutionReturn {
+    auto game_hands = parse_game_hands<JokerRule::Enabled>(input);
+    std::stable_sort(game_hands.begin(), game_hands.end());
 
-        if (contains_joker) {
-            auto max_key = std::max_element(cards_map.begin(), cards_map.end(),
-                                            [](auto const& lhs, auto const& rhs) {
-                                                if (lhs.first == Card::Jack && rhs.first != Card::Jack) return true;
-                                                if (lhs.first != Card::Jack && rhs.first == Card::Jack) return false;
+    SolutionReturn total_winnings = 0;
+    for (auto const& [i, hand] : game_hands | std::views::enumerate) {
+        total_winnings += hand.bid * (i + 1);
+    }
 
-                                                if (lhs.second == rhs.second) {
-                                                    return Hand::to_sequence_value(lhs.first) < Hand::to_sequence_value(rhs.first);
-                                                }
+    return total_winnings;
+}
 
-                                                return lhs.second < rhs.second;
-                                            })->first;
+static constexpr auto CARD_RANKS = [] {
+    constexpr std::string_view RANKS { "23456789TJQKA" };
 
-            if (max_key != Card::Jack) {
-                cards_map[max_key] += cards_map.at(Card::Jack);
-                cards_map.erase(Card::Jack);
-            }
-        }
+    std::array<std::int8_t, 256> ranks{};
+    ranks.fill(-1);
+    for (std::size_t rank = 0; rank < RANKS.size(); ++rank) {
+        ranks[static_cast<unsigned char>(RANKS[rank])] = static_cast<std::int8_t>(rank);
     }
 
-    static auto verify_five_of_a_kind(cards_type const& cards_in) -> bool {
-        std::unordered_map<Card, int> cards_map{};
-
-        for (auto const c : cards_in) {
-            cards_map[c] += 1;
-        }
-
-        if (Hand::enable_joker) {
-            check_joker_and_modify(cards_map);
-        }
+    return ranks;
+}();
 
-        bool five_of_a_kind = std::find_if(cards_map.begin(), cards_map.end(),
-                                           [](auto const& entry) {
-                                               return entry.second == 5;
-                                           }) != cards_map.end();
+// The type only depends on the two largest card counts, with the jokers
+// joining the largest one. A new card only raises its own count, so both stay
+// exact as cards are added one at a time.
+struct LargestCounts {
+    int largest = 0;
+    int second = 0;
 
-        return cards_map.size() == 1 && five_of_a_kind;
+    constexpr auto raise(int count) const -> LargestCounts {
+        return (count > this->largest) ? LargestCounts{ count, this->second } : LargestCounts{ this->largest, std::max(this->second, count) };
     }
 
-    static auto verify_four_of_a_kind(cards_type const& cards_in) -> bool {
-        std::unordered_map<Card, int> cards_map{};
+    constexpr auto type(int jokers) const -> HandType {
+        int const largest = this->largest + jokers;
+        return (largest == 5) ? HandType::FiveOfAKind
+             : (largest == 4) ? HandType::FourOfAKind
+             : (largest == 3) ? ((this->second == 2) ? HandType::FullHouse : HandType::ThreeOfAKind)
+             : (largest == 2) ? ((this->second == 2) ? HandType::TwoPair : HandType::OnePair)
+             : HandType::HighCard;
+    }
+};
 
-        for (auto const c : cards_in) {
-            cards_map[c] += 1;
+// Fills in every hand that starts with the cards counted so far, the joker
+// counts leave the jacks out. Constant evaluation is slow, so the rank counts
+// are packed four bits apiece into one integer, the table is written through
+// a pointer, and the types a fifth card can lead to are worked out once per
+// four cards.
+static constexpr auto fill_hand_types(std::uint8_t*& out, std::uint64_t rank_counts, int cards,
+                                      LargestCounts normal, LargestCounts jokers) -> void {
+    if (cards == 4) {
+        int const jacks = static_cast<int>((rank_counts >> (4 * JACK_RANK)) & 0xF);
+
+        // Both types once the fifth card raises its rank to a count, one byte per count
+        std::uint64_t types_after = 0;
+        for (int count = 1; count <= 5; ++count) {
+            int const types = normal.raise(count).type(0) | (jokers.raise(count).type(jacks) << 4);
+            types_after |= static_cast<std::uint64_t>(types) << (8 * count);
         }
+        int const types_after_jack = normal.raise(jacks + 1).type(0) | (jokers.type(jacks + 1) << 4);
 
-        if (Hand::enable_joker) {
-            check_joker_and_modify(cards_map);
+        for (int rank = 0; rank < 13; ++rank) {
+            auto const count = ((rank_counts >> (4 * rank)) & 0xF) + 1;
+            *out++ = static_cast<std::uint8_t>((rank == JACK_RANK) ? types_after_jack : types_after >> (8 * count));
         }
 
-        bool four_of_a_kind = std::find_if(cards_map.begin(), cards_map.end(),
-                                           [](auto const& entry) {
-                                               return entry.second == 4;
-                                           }) != cards_map.end();
-
-        return cards_map.size() == 2 && four_of_a_kind;
+        return;
     }
 
-    static auto verify_full_house(cards_type const& cards_in) -> bool {
-        std::unordered_map<Card, int> cards_map{};
-
-        for (auto const c : cards_in) {
-            cards_map[c] += 1;
-        }
+    for (int rank = 0; rank < 13; ++rank) {
+        int const count = static_cast<int>((rank_counts >> (4 * rank)) & 0xF) + 1;
+        fill_hand_types(out, rank_counts + (std::uint64_t{1} << (4 * rank)), cards + 1,
+                        normal.raise(count), (rank == JACK_RANK) ? jokers : jokers.raise(count));
+    }
+}
 
-        if (Hand::enable_joker) {
-            check_joker_and_modify(cards_map);
-        }
+static constexpr auto build_hand_type_table() -> std::array<std::uint8_t, HAND_TABLE_SIZE> {
+    std::array<std::uint8_t, HAND_TABLE_SIZE> table{};
+    std::uint8_t* out = table.data();
+    fill_hand_types(out, 0, 0, {}, {});
 
-        bool three_of_a_kind = std::find_if(cards_map.begin(), cards_map.end(),
-                                            [](auto const& entry) {
-                                                return entry.second == 3;
-                                            }) != cards_map.end();
+    return table;
+}
 
-        bool two_of_a_kind = std::find_if(cards_map.begin(), cards_map.end(),
-                                          [](auto const& entry) {
-                                              return entry.second == 2;
-                                          }) != cards_map.end();
+constexpr std::array<std::uint8_t, HAND_TABLE_SIZE> HAND_TYPE_TABLE = build_hand_type_table();
 
-        return cards_map.size() == 2 && three_of_a_kind && two_of_a_kind;
+auto card_rank(char card) -> int {
+    int const rank = CARD_RANKS[static_cast<unsigned char>(card)];
+    if (rank < 0) {
+        throw std::invalid_argument(std::format("not a card: '{}'", card));
     }
 
-    static auto verify_three_of_a_kind(cards_type const& cards_in) -> bool {
-        std::unordered_map<Card, int> cards_map{};
+    return rank;
+}
+
+auto parse_hand_cards(SolutionInput game_hands) -> std::vector<HandCards> {
+    std::vector<HandCards> hands(game_hands.size());
 
-        for (auto const c : cards_in) {
-            cards_map[c] += 1;
+    for (std::size_t i = 0; i < hands.size(); ++i) {
+        std::string_view const line = game_hands[i];
+        auto const [end, error] = std::from_chars(line.data() + std::min<std::size_t>(6, line.size()), line.data() + line.size(), hands[i].bid);
+        if (line.size() < 7 || line[5] != ' ' || error != std::errc{} || end != line.data() + line.size()) {
+            throw std::invalid_argument(std::format("malformed hand: {}", line));
         }
 
-        if (Hand::enable_joker) {
-            check_joker_and_modify(cards_map);
+        for (std::size_t card = 0; card < hands[i].ranks.size(); ++card) {
+            hands[i].ranks[card] = static_cast<std::uint8_t>(card_rank(line[card]));
         }
+    }
 
-        bool three_of_a_kind = std::find_if(cards_map.begin(), cards_map.end(),
-                                            [](auto const& entry) {
-                                                return entry.second == 3;
-                                            }) != cards_map.end();
+    return hands;
+}
 
-        return cards_map.size() == 3 && three_of_a_kind;
+// Keys are 23 bits wide, two passes of 12 bits sort them with both count
+// tables filled in a single read of the hands
+auto rank_hands(std::vector<HandBid>& hands) -> void {
+    static constexpr int RADIX_BITS = 12;
+    static constexpr hand_key_type RADIX_MASK = (1u << RADIX_BITS) - 1;
+
+    std::vector<std::uint32_t> low_offsets(1u << RADIX_BITS, 0);
+    std::vector<std::uint32_t> high_offsets(1u << RADIX_BITS, 0);
+    for (auto const& hand : hands) {
+        ++low_offsets[hand.key & RADIX_MASK];
+        ++high_offsets[hand.key >> RADIX_BITS];
     }
 
-    static auto verify_two_pair(cards_type const& cards_in) -> bool {
-        std::unordered_map<Card, int> cards_map{};
+    std::exclusive_scan(low_offsets.begin(), low_offsets.end(), low_offsets.begin(), 0u);
+    std::exclusive_scan(high_offsets.begin(), high_offsets.end(), high_offsets.begin(), 0u);
 
-        for (auto const c : cards_in) {
-            cards_map[c] += 1;
-        }
-
-        if (Hand::enable_joker) {
-            check_joker_and_modify(cards_map);
-        }
+    std::vector<HandBid> scratch(hands.size());
+    for (auto const& hand : hands) {
+        scratch[low_offsets[hand.key & RADIX_MASK]++] = hand;
+    }
 
-        bool three_of_a_kind = std::find_if(cards_map.begin(), cards_map.end(),
-                                            [](auto const& entry) {
-                                                return entry.second == 3;
-                                            }) != cards_map.end();
+    for (auto const& hand : scratch) {
+        hands[high_offsets[hand.key >> RADIX_BITS]++] = hand;
+    }
+}
 
-        return cards_map.size() == 3 && !three_of_a_kind;
+auto total_winnings(std::span<HandBid const> ranked_hands) -> SolutionReturn {
+    SolutionReturn winnings = 0;
+    for (std::size_t i = 0; i < ranked_hands.size(); ++i) {
+        winnings += static_cast<SolutionReturn>(ranked_hands[i].bid) * static_cast<SolutionReturn>(i + 1);
     }
 
-    static auto verify_one_pair(cards_type const& cards_in) -> bool {
-        std::unordered_map<Card, int> cards_map{};
+    return winnings;
+}
 
-        for (auto const c : cards_in) {
-            cards_map[c] += 1;
-        }
+template<JokerRule Rule>
+static auto radix_winnings(std::span<HandCards const> hands) -> SolutionReturn {
+    auto keyed = key_hands<Rule>(hands);
+    rank_hands(keyed);
+    return total_winnings(keyed);
+}
 
-        if (Hand::enable_joker) {
-            check_joker_and_modify(cards_map);
-        }
+auto camel_cards_winnings(SolutionInput game_hands, std::size_t max_threads) -> CamelCardsWinnings {
+    auto const hands = parse_hand_cards(game_hands);
+    CamelCardsWinnings winnings{};
 
-        bool two_of_a_kind = std::find_if(cards_map.begin(), cards_map.end(),
-                                          [](auto const& entry) {
-                                              return entry.second == 2;
-                                          }) != cards_map.end();
+    parallel::for_each_index(2, [&](std::size_t rule) {
+        if (rule == 0) {
+            winnings.normal = radix_winnings<JokerRule::Disabled>(hands);
+        } else {
+            winnings.jokers = radix_winnings<JokerRule::Enabled>(hands);
+        }
+    }, max_threads);
 
-        return cards_map.size() == 4 && two_of_a_kind;
-    }
+    return winnings;
+}
 
-    friend auto operator<(Hand const& lhs, Hand const& rhs) -> bool {
-        if (lhs.hand == rhs.hand) {
-            for (std::size_t i = 0; i < lhs.cards.size(); ++i) {
-                if (lhs.cards.at(i) != rhs.cards.at(i)) {
-                    return Hand::to_sequence_value(lhs.cards.at(i)) < Hand::to_sequence_value(rhs.cards.at(i));
-                }
+// Position of every possible hand in the ranking under the rules, indexed by
+// the base 13 ranks of its cards
+template<JokerRule Rule>
+static auto hand_positions() -> std::vector<std::uint32_t> const& {
+    static std::vector<std::uint32_t> const positions = [] {
+        std::vector<HandBid> hands(HAND_TABLE_SIZE);
+        for (std::size_t hand_index = 0; hand_index < HAND_TABLE_SIZE; ++hand_index) {
+            HandCards cards{};
+            for (std::size_t card = cards.ranks.size(), rest = hand_index; card-- > 0; rest /= 13) {
+                cards.ranks[card] = static_cast<std::uint8_t>(rest % 13);
             }
-
-            // UNREACHABLE
-            return false;
+            hands[hand_index] = { hand_key<Rule>(cards), static_cast<int>(hand_index) };
         }
+        rank_hands(hands);
 
-        return lhs.hand < rhs.hand;
-    }
-
-private:
-    static auto fill_cards(std::string_view cards_view, cards_type& cards) -> cards_type& {
-        for (auto const [i, c] : cards_view | std::views::enumerate) {
-            cards[i] = static_cast<Card>(c);
+        std::vector<std::uint32_t> positions(HAND_TABLE_SIZE);
+        for (std::size_t position = 0; position < hands.size(); ++position) {
+            positions[hands[position].bid] = static_cast<std::uint32_t>(position);
         }
-        
-        return cards;
-    }
-};
-
-Hand::verifier_type const Hand::verifiers {
-    &Hand::verify_five_of_a_kind,
-    &Hand::verify_four_of_a_kind,
-    &Hand::verify_full_house,
-    &Hand::verify_three_of_a_kind,
-    &Hand::verify_two_pair,
-    &Hand::verify_one_pair
-};
 
-bool Hand::enable_joker = false;
+        return positions;
+    }();
 
-auto parse_game_hands(SolutionInput game_hands) -> std::vector<Hand> {
-    std::vector<Hand> hands{};
+    return positions;
+}
 
-    auto parsed_hands = game_hands
-        | std::views::transform([](auto game_hand) {
-                auto hand_bid_parts = game_hand
-                    | std::views::split(' ');
+template<JokerRule Rule>
+HandLeaderboard<Rule>::HandLeaderboard()
+    : counts(HAND_TABLE_SIZE + 1, 0)
+    , bids(HAND_TABLE_SIZE + 1, 0)
+{
+}
 
-                std::string_view cards{};
-                int bid = 0;
-                for (auto const [i, part] : hand_bid_parts | std::views::enumerate)  {
-                    std::string_view value{part};
-                    if (i == 0) {
-                        cards = value;
-                    } else if (i == 1) {
-                        bid = std::stol(std::string{value.begin(), value.end()});
-                    }
-                }
+template<JokerRule Rule>
+auto HandLeaderboard<Rule>::insert(HandCards const& hand) -> void {
+    std::size_t hand_index = 0;
+    for (auto const rank : hand.ranks) {
+        hand_index = hand_index * 13 + rank;
+    }
+    std::size_t const position = hand_positions<Rule>()[hand_index] + 1;
 
-                return Hand {
-                    cards,
-                    bid
-                };
-            });
+    SolutionReturn hands_at_or_below = 0;
+    SolutionReturn bids_at_or_below = 0;
+    for (std::size_t i = position; i > 0; i &= i - 1) {
+        hands_at_or_below += this->counts[i];
+        bids_at_or_below += this->bids[i];
+    }
 
-    std::ranges::copy(parsed_hands.begin(), parsed_hands.end(), std::back_inserter(hands));
+    for (std::size_t i = position; i < this->counts.size(); i += i & (~i + 1)) {
+        this->counts[i] += 1;
+        this->bids[i] += hand.bid;
+    }
 
-    return hands;
+    this->winnings_total += (this->bid_total - bids_at_or_below) + static_cast<SolutionReturn>(hand.bid) * (hands_at_or_below + 1);
+    this->bid_total += hand.bid;
+    this->hand_count += 1;
 }
 
-auto AoC2023::day7_part1(SolutionInput input) -> SolutionReturn {
-    auto game_hands = parse_game_hands(input);
-    std::sort(game_hands.begin(), game_hands.end());
-
-    int total_winnings = 0;
-    for (auto const& [i, hand] : game_hands | std::views::enumerate) {
-        total_winnings += hand.bid * (i + 1);
+template<JokerRule Rule>
+auto HandLeaderboard<Rule>::insert(std::span<HandCards const> hands) -> SolutionReturn {
+    for (auto const& hand : hands) {
+        this->insert(hand);
     }
 
-    return total_winnings;
+    return this->winnings_total;
 }
 
-auto AoC2023::day7_part2(SolutionInput input) -> SolutionReturn {
-    Hand::enable_joker = true;
-    auto game_hands = parse_game_hands(input);
-    std::sort(game_hands.begin(), game_hands.end());
+template class HandLeaderboard<JokerRule::Disabled>;
+template class HandLeaderboard<JokerRule::Enabled>;
 
-    int total_winnings = 0;
-    for (auto const& [i, hand] : game_hands | std::views::enumerate) {
-        total_winnings += hand.bid * (i + 1);
-    }
+auto AoC2023::day7_part1_radix(SolutionInput input) -> SolutionReturn {
+    return radix_winnings<JokerRule::Disabled>(parse_hand_cards(input));
+}
 
-    return total_winnings;
+auto AoC2023::day7_part2_radix(SolutionInput input) -> SolutionReturn {
+    return radix_winnings<JokerRule::Enabled>(parse_hand_cards(input));
+}
+
+auto AoC2023::day7_part1_leaderboard(SolutionInput input) -> SolutionReturn {
+    return HandLeaderboard<JokerRule::Disabled>{}.insert(parse_hand_cards(input));
+}
+
+auto AoC2023::day7_part2_leaderboard(SolutionInput input) -> SolutionReturn {
+    return HandLeaderboard<JokerRule::Enabled>{}.insert(parse_hand_cards(input));
 }
@@ -0,0 +1,237 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+#include <ranges>
+
+#include "solution.hpp"
+
+enum Card : int {
+    Two = '2',
+    Three = '3',
+    Four = '4',
+    Five = '5',
+    Six = '6',
+    Seven = '7',
+    Eight = '8',
+    Nine = '9',
+    Ten = 'T',
+    Jack = 'J',
+    Queen = 'Q',
+    King = 'K',
+    Ace = 'A'
+};
+
+enum HandType : int {
+    None = 0,
+    HighCard,
+    OnePair,
+    TwoPair,
+    ThreeOfAKind,
+    FullHouse,
+    FourOfAKind,
+    FiveOfAKind
+};
+
+// Whether jacks are jokers, which is the one rule that differs between parts
+enum class JokerRule {
+    Disabled,
+    Enabled
+};
+
+// Rank of a card under the normal rules from 0 for Two, throws
+// std::invalid_argument for anything that is not a card
+auto card_rank(char card) -> int;
+
+static constexpr int JACK_RANK = 9;
+
+// Rank of a card under the given rules, jokers rank below Two
+template<JokerRule Rule>
+constexpr auto rule_rank(int rank) -> int {
+    if constexpr (Rule == JokerRule::Enabled) {
+        return (rank == JACK_RANK) ? 0 : (rank < JACK_RANK) ? rank + 1 : rank;
+    }
+
+    return rank;
+}
+
+static constexpr std::size_t HAND_TABLE_SIZE = 13 * 13 * 13 * 13 * 13;
+
+// Both types of every hand, indexed by the base 13 ranks of its cards under
+// the normal rules. The low four bits hold the normal type and the high four
+// bits the type with jacks as jokers.
+extern std::array<std::uint8_t, HAND_TABLE_SIZE> const HAND_TYPE_TABLE;
+
+template<JokerRule Rule>
+inline auto hand_type(std::size_t hand_index) -> HandType {
+    return static_cast<HandType>((HAND_TYPE_TABLE[hand_index] >> ((Rule == JokerRule::Enabled) ? 4 : 0)) & 0xF);
+}
+
+template<JokerRule Rule>
+struct Hand {
+    using cards_type = std::array<Card, 5>;
+
+    cards_type cards;
+    int bid;
+    HandType hand;
+
+    Hand() = default;
+
+    Hand(std::string_view cards, int bid)
+        : cards(Hand::fill_cards(cards, this->cards))
+        , bid(bid)
+        , hand(Hand::compute_hand(*this))
+    {
+    }
+
+    static auto compute_hand(Hand const& hand_in) -> HandType {
+        std::size_t hand_index = 0;
+        for (auto const card : hand_in.cards) {
+            hand_index = hand_index * 13 + card_rank(static_cast<char>(card));
+        }
+
+        return hand_type<Rule>(hand_index);
+    }
+
+    static auto to_sequence_value(Card card) -> int {
+        switch (card) {
+            case Card::Two:   { return 0; } break;
+            case Card::Three: { return 1; } break;
+            case Card::Four:  { return 2; } break;
+            case Card::Five:  { return 3; } break;
+            case Card::Six:   { return 4; } break;
+            case Card::Seven: { return 5; } break;
+            case Card::Eight: { return 6; } break;
+            case Card::Nine:  { return 7; } break;
+            case Card::Ten:   { return 8; } break;
+            case Card::Jack:  { return (Rule == JokerRule::Enabled) ? -1 : 9; } break;
+            case Card::Queen: { return 10; } break;
+            case Card::King:  { return 11; } break;
+            case Card::Ace:   { return 12; } break;
+            default: return -1; // UNREACHABLE
+        }
+
+        // UNREACHABLE
+        return -1;
+    }
+
+    friend auto operator<(Hand const& lhs, Hand const& rhs) -> bool {
+        if (lhs.hand == rhs.hand) {
+            for (std::size_t i = 0; i < lhs.cards.size(); ++i) {
+                if (lhs.cards.at(i) != rhs.cards.at(i)) {
+                    return Hand::to_sequence_value(lhs.cards.at(i)) < Hand::to_sequence_value(rhs.cards.at(i));
+                }
+            }
+
+            // UNREACHABLE
+            return false;
+        }
+
+        return lhs.hand < rhs.hand;
+    }
+
+private:
+    static auto fill_cards(std::string_view cards_view, cards_type& cards) -> cards_type& {
+        for (auto const [i, c] : cards_view | std::views::enumerate) {
+            cards[i] = static_cast<Card>(c);
+        }
+        
+        return cards;
+    }
+};
+
+template<JokerRule Rule>
+auto parse_game_hands(SolutionInput game_hands) -> std::vector<Hand<Rule>>;
+
+// A hand as read from the input, the card ranks are under the normal rules so
+// that one parse serves both rule sets
+struct HandCards {
+    std::array<std::uint8_t, 5> ranks;
+    int bid;
+};
+
+auto parse_hand_cards(SolutionInput game_hands) -> std::vector<HandCards>;
+
+// A hand packed into one integer, the HandType above the five card ranks with
+// the first card in the highest four bits, so keys order like hands do
+using hand_key_type = std::uint32_t;
+
+static constexpr int HAND_CARD_BITS = 4;
+static constexpr int HAND_TYPE_SHIFT = 5 * HAND_CARD_BITS;
+
+template<JokerRule Rule>
+inline auto hand_key(HandCards const& hand) -> hand_key_type {
+    std::size_t hand_index = 0;
+    hand_key_type key = 0;
+    for (auto const rank : hand.ranks) {
+        hand_index = hand_index * 13 + rank;
+        key = (key << HAND_CARD_BITS) | static_cast<hand_key_type>(rule_rank<Rule>(rank));
+    }
+
+    return (static_cast<hand_key_type>(hand_type<Rule>(hand_index)) << HAND_TYPE_SHIFT) | key;
+}
+
+struct HandBid {
+    hand_key_type key;
+    int bid;
+};
+
+template<JokerRule Rule>
+auto key_hands(std::span<HandCards const> hands) -> std::vector<HandBid> {
+    std::vector<HandBid> keyed(hands.size());
+    for (std::size_t i = 0; i < hands.size(); ++i) {
+        keyed[i] = { hand_key<Rule>(hands[i]), hands[i].bid };
+    }
+
+    return keyed;
+}
+
+// Stable LSD radix sort of the hands by key, weakest first
+auto rank_hands(std::vector<HandBid>& hands) -> void;
+
+// Sum of bid times rank over hands ranked weakest first
+auto total_winnings(std::span<HandBid const> ranked_hands) -> SolutionReturn;
+
+struct CamelCardsWinnings {
+    SolutionReturn normal;
+    SolutionReturn jokers;
+};
+
+// Total winnings under both rule sets from a single parse, ranked side by side
+// on up to max_threads threads
+auto camel_cards_winnings(SolutionInput game_hands, std::size_t max_threads) -> CamelCardsWinnings;
+
+// Total winnings of a growing set of hands, kept in Fenwick trees of hand
+// counts and bids over the position of every possible hand in the ranking.
+// A new hand ranks one past every hand at or below it, so equal hands rank in
+// insertion order like the stable sort, and every hand above it moves up one
+// rank, which adds their bids to the winnings.
+template<JokerRule Rule>
+class HandLeaderboard {
+public:
+    HandLeaderboard();
+
+    auto insert(HandCards const& hand) -> void;
+
+    // Inserts a batch of hands and returns the winnings after it
+    auto insert(std::span<HandCards const> hands) -> SolutionReturn;
+
+    auto winnings() const -> SolutionReturn {
+        return this->winnings_total;
+    }
+
+    auto size() const -> std::size_t {
+        return this->hand_count;
+    }
+
+private:
+    std::vector<std::uint32_t> counts;
+    std::vector<SolutionReturn> bids;
+    SolutionReturn bid_total = 0;
+    SolutionReturn winnings_total = 0;
+    std::size_t hand_count = 0;
+};
@@ -3,10 +3,15 @@
 #include <cstdint>
 #include <cmath>
 #include <cstdlib>
+#include <limits>
 #include <numeric>
+#include <stdexcept>
 #include <string>
 #include <string_view>
 #include <array>
+#include <bit>
+#include <optional>
+#include <span>
 #include <utility>
 #include <map>
 #include <vector>
@@ -17,160 +22,482 @@
 
 #include "aoc2023.hpp"
 #include "solution.hpp"
+#include "day8.hpp"
+#include "parallel.hpp"
 
-struct Network {
-    using node_type = std::pair<std::string, std::string>;
-    using network_type = std::map<std::string, node_type>;
+auto AoC2023::day8_part1(SolutionInput input) -> SolutionReturn {
+    auto const network_map = Network::parse_network(input);
+
+    auto walker = network_map.walker("AAA");
+    std::string_view destination_node{ "ZZZ" };
+
+    int total_steps = 0;
+    while (walker.name() != destination_node) {
+        network_map.next(walker);
+        ++total_steps;
+    }
+
+    return total_steps;
+}
+
+auto ghost_steps_to_z(Network const& network, std::size_t max_threads) -> std::vector<std::int64_t> {
+    std::vector<Network::Walker> walkers{};
+    for (auto const& entry : network.network) {
+        if (entry.first.back() == 'A') {
+            walkers.push_back(Network::Walker{ &entry });
+        }
+    }
+
+    std::vector<std::int64_t> steps_to_z(walkers.size(), 0);
+    parallel::for_each_index(walkers.size(), [&](std::size_t ghost) {
+        auto& walker = walkers[ghost];
+        while (walker.name().back() != 'Z') {
+            network.next(walker);
+            ++steps_to_z[ghost];
+        }
+    }, max_threads);
+
+    return steps_to_z;
+}
+
+auto AoC2023::day8_part2(SolutionInput input) -> SolutionReturn {
+    auto const network_map = Network::parse_network(input);
+
+    std::vector<std::tuple<std::int64_t, std::int64_t>> starting_nodes{};
+    for (auto const steps_to_z : ghost_steps_to_z(network_map, parallel::concurrency())) {
+        starting_nodes.emplace_back(steps_to_z, 0);
+    }
+
+    auto const highest_steps = std::get<0>(
+        *std::max_element(starting_nodes.begin(), starting_nodes.end(),
+                          [](auto const& lhs, auto const& rhs) { return std::get<0>(lhs) < std::get<0>(rhs); })
+    );
+
+    auto const mod_total_steps = [highest_steps](auto const& node) {
+        auto const total_steps = std::get<1>(node);
+        if (total_steps == 0)
+            return false;
+        auto const steps_to_z = std::get<0>(node);
+        auto const step = total_steps / steps_to_z;
+        return (highest_steps * step) % steps_to_z == 0;
+    };
+
+    std::int64_t step = 1;
+    while (std::find_if_not(starting_nodes.begin(), starting_nodes.end(), mod_total_steps) != starting_nodes.end()) {
+        for (auto& [steps_to_z, total_steps] : starting_nodes) {
+            total_steps = steps_to_z * step;
+        }
+        ++step;
+    }
+
+    return std::get<1>(
+        *std::max_element(starting_nodes.begin(), starting_nodes.end(),
+                          [](auto const& lhs, auto const& rhs) { return std::get<1>(lhs) < std::get<1>(rhs); })
+    );
+}
+
+static auto name_digit(char c) -> int {
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+
+    if (c >= 'A' && c <= 'Z') {
+        return c - 'A' + 10;
+    }
+
+    return -1;
+}
+
+static auto name_code(std::string_view name) -> std::optional<std::uint16_t> {
+    if (name.size() != 3) {
+        return std::nullopt;
+    }
+
+    int code = 0;
+    for (char const c : name) {
+        int const digit = name_digit(c);
+        if (digit < 0) {
+            return std::nullopt;
+        }
+        code = code * 36 + digit;
+    }
+
+    return static_cast<std::uint16_t>(code);
+}
+
+auto InternedNetwork::parse(SolutionInput network_description) -> InternedNetwork {
+    if (network_description.empty()) {
+        throw std::invalid_argument("network has no instructions");
+    }
+
+    InternedNetwork network{};
+    std::string_view const instructions = network_description.front();
+    if (instructions.empty()) {
+        throw std::invalid_argument("network has no instructions");
+    }
+
+    network.turn_count = instructions.size();
+    network.turns.assign((instructions.size() + 63) / 64, 0);
+    for (std::size_t step = 0; step < instructions.size(); ++step) {
+        if (instructions[step] != 'L' && instructions[step] != 'R') {
+            throw std::invalid_argument(std::format("not an instruction: '{}'", instructions[step]));
+        }
+        network.turns[step / 64] |= std::uint64_t{ instructions[step] == 'R' } << (step % 64);
+    }
+
+    network.ids.assign(NAME_CODES, NO_NODE);
+    std::vector<bool> defined{};
+    auto const intern = [&](std::string_view name, std::string_view line) {
+        auto const code = name_code(name);
+        if (!code) {
+            throw std::invalid_argument(std::format("malformed node: {}", line));
+        }
+
+        auto& id = network.ids[*code];
+        if (id == NO_NODE) {
+            id = static_cast<node_id_type>(network.names.size());
+            network.names.push_back(*code);
+            network.edges[0].push_back(NO_NODE);
+            network.edges[1].push_back(NO_NODE);
+            defined.push_back(false);
+        }
+
+        return id;
+    };
+
+    // Every line reads "AAA = (BBB, CCC)"
+    for (std::string_view const line : network_description | std::views::drop(1)) {
+        if (line.empty()) {
+            continue;
+        }
+
+        if (line.size() != 16 || line.substr(3, 4) != " = (" || line.substr(10, 2) != ", " || line.back() != ')') {
+            throw std::invalid_argument(std::format("malformed node: {}", line));
+        }
+
+        auto const node = intern(line.substr(0, 3), line);
+        auto const left = intern(line.substr(7, 3), line);
+        auto const right = intern(line.substr(12, 3), line);
+        network.edges[0][node] = left;
+        network.edges[1][node] = right;
+        defined[node] = true;
+    }
+
+    for (std::size_t node = 0; node < defined.size(); ++node) {
+        if (!defined[node]) {
+            throw std::invalid_argument("network references a node without edges");
+        }
+    }
+
+    return network;
+}
+
+auto InternedNetwork::id(std::string_view name) const -> std::optional<node_id_type> {
+    auto const code = name_code(name);
+    if (!code || this->ids[*code] == NO_NODE) {
+        return std::nullopt;
+    }
+
+    return this->ids[*code];
+}
+
+auto InternedNetwork::ends_with(node_id_type node, char suffix) const -> bool {
+    return this->names[node] % 36 == name_digit(suffix);
+}
 
-    std::string steps;
-    network_type network;
-    std::size_t cursor;
+auto AoC2023::day8_part1_interned(SolutionInput input) -> SolutionReturn {
+    auto const network = InternedNetwork::parse(input);
+    auto const start = network.id("AAA");
+    auto const target = network.id("ZZZ");
+    if (!start || !target) {
+        throw std::invalid_argument("network needs nodes AAA and ZZZ");
+    }
 
-    auto next(std::string const& current_node) -> std::string_view {
-        auto& node = (this->steps.at(this->cursor) == 'L')
-            ? this->network.at(current_node).first
-            : this->network.at(current_node).second;
+    // Past one visit of every (node, instruction) pair the walk is in a cycle
+    SolutionReturn const max_steps = static_cast<SolutionReturn>(network.node_count() * network.turn_count);
 
-        this->advance();
+    auto node = *start;
+    SolutionReturn steps = 0;
+    for (std::size_t step = 0; node != *target; ++steps) {
+        if (steps > max_steps) {
+            throw std::out_of_range("ZZZ is not reachable from AAA");
+        }
 
-        return node;
+        node = network.next(node, step);
+        step = (step + 1 == network.turn_count) ? 0 : step + 1;
     }
 
-    auto peek(std::string const& current_node) -> std::string_view {
-        return (this->steps.at(this->cursor) == 'L')
-            ? this->network.at(current_node).first
-            : this->network.at(current_node).second;
+    return steps;
+}
+
+// Sentinels of PassJumps::z_steps
+static constexpr std::uint64_t Z_UNKNOWN = std::numeric_limits<std::uint64_t>::max();
+static constexpr std::uint64_t Z_NEVER = Z_UNKNOWN - 1;
+static constexpr std::uint64_t Z_PENDING = Z_UNKNOWN - 2;
+
+PassJumps::PassJumps(InternedNetwork network) : walked{ std::move(network) } {
+    auto const node_count = this->walked.node_count();
+
+    std::vector<node_id_type> pass(node_count);
+    for (std::size_t start = 0; start < node_count; ++start) {
+        auto node = static_cast<node_id_type>(start);
+        for (std::size_t step = 0; step < this->walked.turn_count; ++step) {
+            node = this->walked.next(node, step);
+        }
+        pass[start] = node;
     }
 
-    auto advance() -> void {
-        if (this->cursor >= steps.size() - 1) {
-            this->cursor = 0;
-        } else {
-            ++this->cursor;
+    // Only as many levels as a 64 bit step count has whole passes
+    auto const levels = static_cast<std::size_t>(std::bit_width(std::numeric_limits<std::uint64_t>::max() / this->walked.turn_count));
+    this->jumps.reserve(levels);
+    this->jumps.push_back(std::move(pass));
+    while (this->jumps.size() < levels) {
+        auto const& half = this->jumps.back();
+        std::vector<node_id_type> level(node_count);
+        for (std::size_t node = 0; node < node_count; ++node) {
+            level[node] = half[half[node]];
         }
+        this->jumps.push_back(std::move(level));
     }
 
-    auto reset_cursor() -> void {
-        this->cursor = 0;
+    this->z_steps.assign(node_count, Z_UNKNOWN);
+}
+
+auto PassJumps::position(node_id_type start, std::uint64_t steps) const -> node_id_type {
+    auto node = start;
+    auto passes = steps / this->walked.turn_count;
+    for (std::size_t level = 0; passes != 0; ++level, passes >>= 1) {
+        if (passes & 1) {
+            node = this->jumps[level][node];
+        }
     }
 
-    static auto parse_node(std::string_view node_expression) -> std::pair<std::string, node_type> {
-        auto expression_parts = node_expression
-            | std::views::filter([](auto c) { return c != ' ' && c != '(' && c != ')'; })
-            | std::views::split('=');
+    auto const remainder = static_cast<std::size_t>(steps % this->walked.turn_count);
+    for (std::size_t step = 0; step < remainder; ++step) {
+        node = this->walked.next(node, step);
+    }
 
-        std::string node_key{expression_parts.front().begin(), expression_parts.front().end()};
-        std::string left_edge;
-        std::string right_edge;
+    return node;
+}
 
-        for (auto const left_right : expression_parts | std::views::drop(1)) {
-            auto edge_node_parts = left_right
-                | std::views::split(',');
+auto PassJumps::positions(std::span<node_id_type const> starts, std::uint64_t steps) const -> std::vector<node_id_type> {
+    std::vector<node_id_type> nodes(starts.begin(), starts.end());
 
-            for (auto const [i, edge] : edge_node_parts | std::views::enumerate) {
-                std::string& edge_container = (i == 0)
-                    ? left_edge
-                    : right_edge;
-                edge_container = std::string{edge.begin(), edge.end()};
+    // Level by level over all starts, so each table is streamed once
+    auto passes = steps / this->walked.turn_count;
+    for (std::size_t level = 0; passes != 0; ++level, passes >>= 1) {
+        if (passes & 1) {
+            for (auto& node : nodes) {
+                node = this->jumps[level][node];
             }
         }
+    }
+
+    auto const remainder = static_cast<std::size_t>(steps % this->walked.turn_count);
+    for (std::size_t step = 0; step < remainder; ++step) {
+        for (auto& node : nodes) {
+            node = this->walked.next(node, step);
+        }
+    }
+
+    return nodes;
+}
+
+auto PassJumps::pass_z(node_id_type start) const -> std::optional<std::uint64_t> {
+    auto node = start;
+    for (std::size_t step = 0; step < this->walked.turn_count; ++step) {
+        node = this->walked.next(node, step);
+        if (this->walked.ends_with(node, 'Z')) {
+            return step + 1;
+        }
+    }
 
-        return {
-            node_key,
-            { left_edge, right_edge }
-        };
+    return std::nullopt;
+}
+
+auto PassJumps::first_z(node_id_type start) -> std::optional<std::uint64_t> {
+    // Follow whole passes until a node with a known answer, a pass with a Z
+    // node, or a node already on this walk, which is a loop without Z nodes
+    std::vector<node_id_type> walk{};
+    auto node = start;
+    while (this->z_steps[node] == Z_UNKNOWN) {
+        if (auto const steps = this->pass_z(node)) {
+            this->z_steps[node] = *steps;
+            break;
+        }
+
+        this->z_steps[node] = Z_PENDING;
+        walk.push_back(node);
+        node = this->jumps[0][node];
     }
 
-    static auto parse_network(SolutionInput network_description) -> Network {
-    Network network_map{};
+    auto steps = (this->z_steps[node] == Z_PENDING) ? Z_NEVER : this->z_steps[node];
+    for (auto const passed : walk | std::views::reverse) {
+        steps = (steps == Z_NEVER) ? Z_NEVER : steps + this->walked.turn_count;
+        this->z_steps[passed] = steps;
+    }
 
-    auto network_chunks = network_description
-        | std::views::chunk_by([](auto lhs, auto rhs) {
-                return lhs != "" && rhs != "";
-            })
-        | std::views::filter([](auto chunk) {
-                return chunk[0] != "";
-            });
+    if (this->z_steps[start] == Z_NEVER) {
+        return std::nullopt;
+    }
+
+    return this->z_steps[start];
+}
 
-    for (auto const [i, chunk] : network_chunks | std::views::enumerate) {
-        if (i == 0) {
-            network_map.steps = chunk[0];
-        } else {
-            for (auto const& segment : chunk) {
-                auto node = Network::parse_node(segment);
-                network_map.network[node.first] = node.second;
+auto GhostCycle::from_walk(InternedNetwork const& network, InternedNetwork::node_id_type start) -> GhostCycle {
+    auto const pass_length = static_cast<std::int64_t>(network.turn_count);
+    std::vector<std::int64_t> pass_of(network.node_count(), -1);
+    std::vector<std::int64_t> hits{};
+
+    // A whole pass at a time, only the node a pass starts on decides the rest
+    auto node = start;
+    std::int64_t time = 0;
+    for (std::int64_t pass = 0; pass_of[node] < 0; ++pass) {
+        pass_of[node] = pass;
+        for (std::size_t step = 0; step < network.turn_count; ++step, ++time) {
+            if (network.ends_with(node, 'Z')) {
+                hits.push_back(time);
             }
+            node = network.next(node, step);
         }
     }
 
-    return network_map;
+    GhostCycle ghost{};
+    ghost.cycle_start = pass_of[node] * pass_length;
+    ghost.cycle_length = time - ghost.cycle_start;
+
+    auto const cycle_hits = std::ranges::lower_bound(hits, ghost.cycle_start);
+    ghost.prefix_hits.assign(hits.begin(), cycle_hits);
+    ghost.cycle_hits.assign(cycle_hits, hits.end());
+
+    return ghost;
 }
 
-};
+auto GhostCycle::at_z(std::int64_t time) const -> bool {
+    if (time < this->cycle_start) {
+        return std::ranges::binary_search(this->prefix_hits, time);
+    }
 
-auto AoC2023::day8_part1(SolutionInput input) -> SolutionReturn {
-    auto network_map = Network::parse_network(input);
+    return std::ranges::binary_search(this->cycle_hits, this->cycle_start + (time - this->cycle_start) % this->cycle_length);
+}
 
-    std::string current_node{ "AAA" };
-    std::string_view destination_node{ "ZZZ" };
+auto analyse_ghosts(InternedNetwork const& network, std::size_t max_threads) -> std::vector<GhostCycle> {
+    std::vector<InternedNetwork::node_id_type> starts{};
+    for (std::size_t node = 0; node < network.node_count(); ++node) {
+        if (network.ends_with(static_cast<InternedNetwork::node_id_type>(node), 'A')) {
+            starts.push_back(static_cast<InternedNetwork::node_id_type>(node));
+        }
+    }
 
-    int total_steps = 0;
-    while (current_node != destination_node) {
-        current_node = network_map.next(current_node);
-        ++total_steps;
+    std::vector<GhostCycle> ghosts(starts.size());
+    parallel::for_each_index(starts.size(), [&](std::size_t ghost) {
+        ghosts[ghost] = GhostCycle::from_walk(network, starts[ghost]);
+    }, max_threads);
+
+    return ghosts;
+}
+
+__extension__ using cycle_wide_type = __int128;
+
+// Residues of the times that satisfy every ghost combined so far, all modulo
+// one shared period
+struct CommonResidues {
+    std::vector<std::int64_t> residues;
+    std::int64_t period;
+};
+
+static auto modular_inverse(std::int64_t value, std::int64_t modulus) -> std::int64_t {
+    std::int64_t old_r = value;
+    std::int64_t r = modulus;
+    std::int64_t old_s = 1;
+    std::int64_t s = 0;
+    while (r != 0) {
+        std::int64_t const quotient = old_r / r;
+        old_r = std::exchange(r, old_r - quotient * r);
+        old_s = std::exchange(s, old_s - quotient * s);
     }
 
-    return total_steps;
+    return ((old_s % modulus) + modulus) % modulus;
 }
 
-auto AoC2023::day8_part2(SolutionInput input) -> SolutionReturn {
-    auto network_map = Network::parse_network(input);
+// Generalised CRT on every pair of residues, x = a (mod M) and x = b (mod m)
+// have a common solution modulo lcm(M, m) exactly when gcd(M, m) divides b - a
+static auto combine_residues(CommonResidues const& common, std::span<std::int64_t const> residues, std::int64_t period) -> CommonResidues {
+    static constexpr std::size_t MAX_RESIDUES = std::size_t{1} << 20;
 
-    auto starting_nodes_view = network_map.network
-        | std::views::filter([](auto const& node) { return node.first.back() == 'A'; })
-        | std::views::transform([](auto const& node) { return std::tuple { node.first, 0ll, 0ll }; });
+    std::int64_t const divisor = std::gcd(common.period, period);
+    cycle_wide_type const combined_period = static_cast<cycle_wide_type>(common.period / divisor) * period;
+    if (combined_period > std::numeric_limits<std::int64_t>::max()) {
+        throw std::overflow_error("ghost cycles have a common period beyond 64 bits");
+    }
 
-    std::vector<std::tuple<std::string, std::int64_t, std::int64_t>> starting_nodes {
-        starting_nodes_view.begin(),
-        starting_nodes_view.end()
-    };
+    std::int64_t const reduced_period = period / divisor;
+    std::int64_t const inverse = (reduced_period == 1) ? 0 : modular_inverse((common.period / divisor) % reduced_period, reduced_period);
 
-    auto constexpr identical_nodes = [](auto const& node) {
-        return node.back() == 'Z';
-    };
+    CommonResidues combined{ {}, static_cast<std::int64_t>(combined_period) };
+    for (auto const a : common.residues) {
+        for (auto const b : residues) {
+            if ((b - a) % divisor != 0) {
+                continue;
+            }
 
-    for (auto& [current_node, steps_to_z, total_steps] : starting_nodes) {
-        while (!identical_nodes(current_node)) {
-            current_node = network_map.next(current_node);
-            ++steps_to_z;
+            std::int64_t const k = static_cast<std::int64_t>((static_cast<cycle_wide_type>((b - a) / divisor % reduced_period + reduced_period) * inverse) % reduced_period);
+            combined.residues.push_back(static_cast<std::int64_t>((a + static_cast<cycle_wide_type>(common.period) * k) % combined_period));
+            if (combined.residues.size() > MAX_RESIDUES) {
+                throw std::length_error("too many common ghost residues");
+            }
         }
-        network_map.reset_cursor();
     }
 
-    auto const highest_steps = std::get<1>(
-        *std::max_element(starting_nodes.begin(), starting_nodes.end(),
-                          [](auto const& lhs, auto const& rhs) { return std::get<1>(lhs) < std::get<1>(rhs); })
-    );
+    std::ranges::sort(combined.residues);
+    combined.residues.erase(std::ranges::unique(combined.residues).begin(), combined.residues.end());
 
-    auto const mod_total_steps = [highest_steps](auto const& node) {
-        auto const total_steps = std::get<2>(node);
-        if (total_steps == 0)
-            return false;
-        auto const steps_to_z = std::get<1>(node);
-        auto const step = total_steps / steps_to_z;
-        return (highest_steps * step) % steps_to_z == 0;
+    return combined;
+}
+
+auto first_common_z(std::span<GhostCycle const> ghosts) -> std::optional<std::int64_t> {
+    if (ghosts.empty()) {
+        return std::nullopt;
+    }
+
+    auto const& latest = *std::ranges::max_element(ghosts, {}, &GhostCycle::cycle_start);
+    auto const all_at_z = [ghosts](std::int64_t time) {
+        return std::ranges::all_of(ghosts, [time](auto const& ghost) { return ghost.at_z(time); });
     };
 
-    std::int64_t step = 1;
-    while (std::find_if_not(starting_nodes.begin(), starting_nodes.end(), mod_total_steps) != starting_nodes.end()) {
-        for (auto& [current_node, steps_to_z, total_steps] : starting_nodes) {
-            total_steps = steps_to_z * step;
+    // Before the last cycle starts that ghost can only be on its prefix hits
+    for (auto const time : latest.prefix_hits) {
+        if (all_at_z(time)) {
+            return time;
         }
-        ++step;
     }
 
-    return std::get<2>(
-        *std::max_element(starting_nodes.begin(), starting_nodes.end(),
-                          [](auto const& lhs, auto const& rhs) { return std::get<2>(lhs) < std::get<2>(rhs); })
-    );
+    // From there on every ghost repeats, so the answer is a residue of the
+    // common period
+    CommonResidues common{ { 0 }, 1 };
+    for (auto const& ghost : ghosts) {
+        std::vector<std::int64_t> residues(ghost.cycle_hits.size());
+        std::ranges::transform(ghost.cycle_hits, residues.begin(), [&ghost](std::int64_t hit) { return hit % ghost.cycle_length; });
+        common = combine_residues(common, residues, ghost.cycle_length);
+    }
+
+    std::optional<std::int64_t> first{};
+    for (auto const residue : common.residues) {
+        std::int64_t const time = latest.cycle_start + ((residue - latest.cycle_start % common.period) % common.period + common.period) % common.period;
+        first = std::min(first.value_or(time), time);
+    }
+
+    return first;
+}
+
+auto AoC2023::day8_part2_cycles(SolutionInput input) -> SolutionReturn {
+    auto const network = InternedNetwork::parse(input);
+    auto const ghosts = analyse_ghosts(network, parallel::concurrency());
+
+    auto const steps = first_common_z(ghosts);
+    if (!steps) {
+        throw std::out_of_range("the ghosts never stand on Z nodes together");
+    }
+
+    return *steps;
 }
@@ -0,0 +1,242 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <format>
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "solution.hpp"
+
+struct Network {
+    struct Node;
+    using entry_type = std::pair<std::string const, Node>;
+
+    struct Node {
+        std::string left;
+        std::string right;
+        // The entries the edges lead to, null for an edge to a missing node
+        std::array<entry_type const*, 2> edges;
+    };
+
+    using node_type = Node;
+    using network_type = std::map<std::string, node_type>;
+
+    std::string steps;
+    network_type network;
+
+    // Nodes point at the map entries of their edges, which survive a move of
+    // the map but not a copy
+    Network() = default;
+    Network(Network&&) = default;
+    Network(Network const&) = delete;
+    auto operator=(Network&&) -> Network& = default;
+    auto operator=(Network const&) -> Network& = delete;
+
+    // Where one walk stands, the network itself never changes, so any number
+    // of walkers can move over it at once
+    struct Walker {
+        entry_type const* node;
+        std::size_t cursor = 0;
+
+        auto name() const -> std::string const& {
+            return this->node->first;
+        }
+    };
+
+    auto walker(std::string const& start) const -> Walker {
+        auto const node = this->network.find(start);
+        if (node == this->network.end()) {
+            throw std::out_of_range(std::format("no node named {}", start));
+        }
+
+        return Walker{ &*node };
+    }
+
+    auto next(Walker& walker) const -> std::string_view {
+        auto const* node = walker.node->second.edges[(this->steps.at(walker.cursor) == 'L') ? 0 : 1];
+        if (node == nullptr) {
+            throw std::out_of_range(std::format("no node named {}", this->peek(walker)));
+        }
+
+        walker.node = node;
+        walker.cursor = (walker.cursor + 1 >= this->steps.size()) ? 0 : walker.cursor + 1;
+
+        return walker.name();
+    }
+
+    auto peek(Walker const& walker) const -> std::string const& {
+        auto const& edges = walker.node->second;
+        return (this->steps.at(walker.cursor) == 'L')
+            ? edges.left
+            : edges.right;
+    }
+
+    static auto parse_node(std::string_view node_expression) -> std::pair<std::string, node_type> {
+        auto expression_parts = node_expression
+            | std::views::filter([](auto c) { return c != ' ' && c != '(' && c != ')'; })
+            | std::views::split('=');
+
+        std::string node_key{expression_parts.front().begin(), expression_parts.front().end()};
+        std::string left_edge;
+        std::string right_edge;
+
+        for (auto const left_right : expression_parts | std::views::drop(1)) {
+            auto edge_node_parts = left_right
+                | std::views::split(',');
+
+            for (auto const [i, edge] : edge_node_parts | std::views::enumerate) {
+                std::string& edge_container = (i == 0)
+                    ? left_edge
+                    : right_edge;
+                edge_container = std::string{edge.begin(), edge.end()};
+            }
+        }
+
+        return {
+            node_key,
+            { left_edge, right_edge, {} }
+        };
+    }
+
+    static auto parse_network(SolutionInput network_description) -> Network {
+    Network network_map{};
+
+    auto network_chunks = network_description
+        | std::views::chunk_by([](auto lhs, auto rhs) {
+                return lhs != "" && rhs != "";
+            })
+        | std::views::filter([](auto chunk) {
+                return chunk[0] != "";
+            });
+
+    for (auto const [i, chunk] : network_chunks | std::views::enumerate) {
+        if (i == 0) {
+            network_map.steps = chunk[0];
+        } else {
+            for (auto const& segment : chunk) {
+                auto node = Network::parse_node(segment);
+                network_map.network[node.first] = node.second;
+            }
+        }
+    }
+
+    // Every edge is looked up once here, a step then only follows a pointer
+    auto const resolve = [&network_map](std::string const& name) -> entry_type const* {
+        auto const entry = network_map.network.find(name);
+        return (entry != network_map.network.end()) ? &*entry : nullptr;
+    };
+
+    for (auto& [name, node] : network_map.network) {
+        node.edges = { resolve(node.left), resolve(node.right) };
+    }
+
+    return network_map;
+}
+
+};
+
+// Steps each ghost starting on a node ending in A takes to its first node
+// ending in Z, the ghosts are walked on up to max_threads threads
+auto ghost_steps_to_z(Network const& network, std::size_t max_threads) -> std::vector<std::int64_t>;
+
+// The network with every node name interned into a dense id in order of
+// appearance. The instructions are a bit vector with R set, and the edges two
+// flat arrays indexed by id, so a step is one load of the turn and one of the
+// edge it picks.
+struct InternedNetwork {
+    using node_id_type = std::uint16_t;
+
+    // Names are three base 36 digits
+    static constexpr std::size_t NAME_CODES = 36 * 36 * 36;
+    static constexpr node_id_type NO_NODE = static_cast<node_id_type>(-1);
+
+    std::vector<std::uint64_t> turns;
+    std::size_t turn_count;
+    std::array<std::vector<node_id_type>, 2> edges;
+    std::vector<std::uint16_t> names;
+    std::vector<node_id_type> ids;
+
+    // Throws std::invalid_argument on malformed lines or nodes without edges
+    static auto parse(SolutionInput network_description) -> InternedNetwork;
+
+    auto node_count() const -> std::size_t {
+        return this->names.size();
+    }
+
+    auto id(std::string_view name) const -> std::optional<node_id_type>;
+
+    // Whether the name of the node ends in `suffix`
+    auto ends_with(node_id_type node, char suffix) const -> bool;
+
+    // 0 for L and 1 for R
+    auto turn(std::size_t step) const -> std::size_t {
+        return (this->turns[step / 64] >> (step % 64)) & 1;
+    }
+
+    auto next(node_id_type node, std::size_t step) const -> node_id_type {
+        return this->edges[this->turn(step)][node];
+    }
+};
+
+// Walk queries against a fixed network without stepping through it. Level j
+// of the jump tables maps a node to where a walk starting on it at the first
+// instruction stands after 2^j whole passes of the instructions, so a walk of
+// k steps is one jump per set bit of k / turn_count and under one pass of
+// single steps.
+struct PassJumps {
+    using node_id_type = InternedNetwork::node_id_type;
+
+    explicit PassJumps(InternedNetwork network);
+
+    // Node reached after `steps` steps from start
+    auto position(node_id_type start, std::uint64_t steps) const -> node_id_type;
+    auto positions(std::span<node_id_type const> starts, std::uint64_t steps) const -> std::vector<node_id_type>;
+
+    // Steps after which a walk from start first stands on a node ending in Z,
+    // or nullopt if it never does. Answers are memoised per node, so a later
+    // walk stops at the first pass start it shares with an earlier one.
+    auto first_z(node_id_type start) -> std::optional<std::uint64_t>;
+
+    auto network() const -> InternedNetwork const& {
+        return this->walked;
+    }
+
+private:
+    // First step within one pass from `start` that stands on a Z node
+    auto pass_z(node_id_type start) const -> std::optional<std::uint64_t>;
+
+    InternedNetwork walked;
+    std::vector<std::vector<node_id_type>> jumps;
+    std::vector<std::uint64_t> z_steps;
+};
+
+// Times at which a ghost walking from one node stands on a Z node. Once a node
+// comes back at the start of the instructions the walk repeats, from
+// cycle_start on the ghost is on a Z node exactly at the times congruent to
+// one of the cycle hits modulo cycle_length.
+struct GhostCycle {
+    std::vector<std::int64_t> prefix_hits;
+    std::int64_t cycle_start;
+    std::int64_t cycle_length;
+    std::vector<std::int64_t> cycle_hits;
+
+    static auto from_walk(InternedNetwork const& network, InternedNetwork::node_id_type start) -> GhostCycle;
+
+    auto at_z(std::int64_t time) const -> bool;
+};
+
+// Cycles of the ghosts starting on every node ending in A, walked on up to
+// max_threads threads
+auto analyse_ghosts(InternedNetwork const& network, std::size_t max_threads) -> std::vector<GhostCycle>;
+
+// First time all ghosts stand on Z nodes together, or nullopt if they never
+// do, throws std::overflow_error when the combined period leaves 64 bits
+auto first_common_z(std::span<GhostCycle const> ghosts) -> std::optional<std::int64_t>;
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <span>
+#include <vector>
+#include <ranges>
+
+#include "solution.hpp"
+
+struct PolynomialSequence {
+    std::vector<std::int64_t> values;
+    int depth;
+    std::unique_ptr<PolynomialSequence> next;
+
+    PolynomialSequence(std::span<std::int64_t> values_view, int depth_in)
+        : values({})
+        , depth(depth_in)
+        , next(nullptr)
+    {
+        std::ranges::move(values_view, std::back_inserter(this->values));
+        auto differences = this->values
+            | std::views::pairwise
+            | std::views::transform([](auto const& pair) {
+                    return std::get<1>(pair) - std::get<0>(pair);
+                });
+
+        // https://en.wikipedia.org/wiki/Arithmetic_progression#Sum
+        // Interestingly, the arithmetic sum only works for integers >= 0
+        // auto arithmetic_sum = (differences.size() * (differences.front() + differences.back())) / 2;
+
+        if (std::ranges::find_if_not(differences, [](auto const n) { return n == 0; }) != differences.end()) {
+            std::vector<std::int64_t> next_values{};
+            std::ranges::move(differences, std::back_inserter(next_values));
+            this->next.reset(new PolynomialSequence{ next_values, depth_in + 1 });
+        }
+    }
+
+    auto at(int depth) -> std::optional<std::reference_wrapper<PolynomialSequence>> {
+        if (depth == this->depth) {
+            return std::ref(*this);
+        } else if (this->next != nullptr) {
+            return this->next->at(depth);
+        }
+
+        return std::nullopt;
+    }
+
+    auto max_depth() -> int {
+        if (this->next == nullptr) {
+            return this->depth;
+        }
+
+        return this->next->max_depth();
+    }
+};
+
+auto parse_oasis_report(SolutionInput oasis_report) -> std::vector<PolynomialSequence>;
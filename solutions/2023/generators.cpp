@@ -0,0 +1,505 @@
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cctype>
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <ranges>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include <format>
+
+#include "aoc2023.hpp"
+#include "solution.hpp"
+
+// Every generator produces puzzle input in the same shape as the real input,
+// and the size of that input grows roughly linearly with `scale`.
+
+using generator_engine_type = std::mt19937_64;
+
+static auto uniform(generator_engine_type& engine, std::int64_t lo, std::int64_t hi) -> std::int64_t {
+    return std::uniform_int_distribution<std::int64_t>(lo, hi)(engine);
+}
+
+static auto unique_numbers(generator_engine_type& engine, std::size_t count, int lo, int hi) -> std::vector<int> {
+    std::vector<int> pool(hi - lo + 1);
+    std::iota(pool.begin(), pool.end(), lo);
+    std::shuffle(pool.begin(), pool.end(), engine);
+    pool.resize(std::min(count, pool.size()));
+    return pool;
+}
+
+auto AoC2023::generate_day1(std::size_t scale, std::uint64_t seed) -> SolutionInputValue {
+    static constexpr std::array<std::string_view, 10> NUMBER_WORDS {
+        "zero", "one", "two", "three", "four", "five", "six", "seven", "eight", "nine"
+    };
+
+    generator_engine_type engine(seed);
+    SolutionInputValue lines{};
+    lines.reserve(1000 * scale);
+
+    for (std::size_t i = 0; i < 1000 * scale; ++i) {
+        std::string line{};
+        auto const length = uniform(engine, 8, 40);
+        for (std::int64_t j = 0; j < length; ++j) {
+            line += static_cast<char>('a' + uniform(engine, 0, 25));
+        }
+
+        for (auto digits = uniform(engine, 1, 3); digits > 0; --digits) {
+            line.insert(uniform(engine, 0, line.size()), 1, static_cast<char>('0' + uniform(engine, 1, 9)));
+        }
+
+        for (auto words = uniform(engine, 0, 3); words > 0; --words) {
+            line.insert(uniform(engine, 0, line.size()), NUMBER_WORDS.at(uniform(engine, 1, 9)));
+        }
+
+        lines.push_back(std::move(line));
+    }
+
+    return lines;
+}
+
+auto AoC2023::generate_day2(std::size_t scale, std::uint64_t seed) -> SolutionInputValue {
+    static constexpr std::array<std::string_view, 3> COLORS { "red", "green", "blue" };
+
+    generator_engine_type engine(seed);
+    SolutionInputValue lines{};
+    lines.reserve(100 * scale);
+
+    for (std::size_t id = 1; id <= 100 * scale; ++id) {
+        std::string line = std::format("Game {}:", id);
+
+        for (auto rounds = uniform(engine, 1, 6); rounds > 0; --rounds) {
+            std::array<std::size_t, 3> order { 0, 1, 2 };
+            std::shuffle(order.begin(), order.end(), engine);
+            auto const colors = uniform(engine, 1, 3);
+
+            for (std::int64_t c = 0; c < colors; ++c) {
+                line += std::format(" {} {}{}", uniform(engine, 1, 20), COLORS.at(order.at(c)), (c + 1 < colors) ? "," : "");
+            }
+
+            line += (rounds > 1) ? ";" : "";
+        }
+
+        lines.push_back(std::move(line));
+    }
+
+    return lines;
+}
+
+auto AoC2023::generate_day3(std::size_t scale, std::uint64_t seed) -> SolutionInputValue {
+    static constexpr std::string_view SYMBOLS { "@#$%&*-=+/" };
+    static constexpr std::size_t WIDTH = 140;
+
+    generator_engine_type engine(seed);
+    SolutionInputValue lines{};
+    lines.reserve(WIDTH * scale);
+
+    for (std::size_t i = 0; i < WIDTH * scale; ++i) {
+        std::string line{};
+        bool number_token = true;
+
+        while (line.size() < WIDTH) {
+            if (number_token) {
+                line += std::to_string(uniform(engine, 1, 999));
+            } else {
+                line += (uniform(engine, 0, 3) == 0) ? '*' : SYMBOLS.at(uniform(engine, 0, SYMBOLS.size() - 1));
+            }
+
+            line.append(uniform(engine, 1, 4), '.');
+            number_token = uniform(engine, 0, 9) < 6;
+        }
+
+        // Numbers never touch the right edge, a number cut short by the
+        // resize is blanked out
+        line.resize(WIDTH, '.');
+        for (auto c = line.rbegin(); c != line.rend() && std::isdigit(*c); ++c) {
+            *c = '.';
+        }
+
+        lines.push_back(std::move(line));
+    }
+
+    return lines;
+}
+
+auto AoC2023::generate_day4(std::size_t scale, std::uint64_t seed) -> SolutionInputValue {
+    // Most cards win several copies like in the real input, so copies cascade
+    // through the deck. A card that already holds CASCADE_LIMIT copies wins
+    // nothing, no card can then hold more than eleven times the limit, which
+    // keeps the part 2 total inside 64 bits at any scale.
+    static constexpr std::array<int, 16> MATCH_WEIGHTS {
+        0, 0, 0, 1, 1, 2, 2, 3, 4, 5, 6, 7, 8, 9, 10, 10
+    };
+    static constexpr std::int64_t CASCADE_LIMIT = 1ll << 24;
+
+    generator_engine_type engine(seed);
+    auto const card_count = 200 * scale;
+    SolutionInputValue lines{};
+    lines.reserve(card_count);
+
+    std::vector<std::int64_t> won_copies(card_count + 1, 0);
+    std::int64_t window_copies = 0;
+
+    for (std::size_t id = 1; id <= card_count; ++id) {
+        auto numbers = unique_numbers(engine, 35, 1, 99);
+        std::vector<int> winning_numbers{ numbers.begin(), numbers.begin() + 10 };
+        std::vector<int> draw_numbers{ numbers.begin() + 10, numbers.end() };
+
+        window_copies += won_copies.at(id - 1);
+        auto const copies = window_copies + 1;
+        auto const matches = (copies >= CASCADE_LIMIT) ? 0 : MATCH_WEIGHTS.at(uniform(engine, 0, MATCH_WEIGHTS.size() - 1));
+        if (matches > 0) {
+            won_copies.at(id) += copies;
+            won_copies.at(std::min(card_count, id + matches)) -= copies;
+        }
+
+        std::copy(winning_numbers.begin(), winning_numbers.begin() + matches, draw_numbers.begin());
+        std::shuffle(draw_numbers.begin(), draw_numbers.end(), engine);
+
+        std::string line = std::format("Card {:>3}:", id);
+        for (auto const n : winning_numbers) { line += std::format(" {:>2}", n); }
+        line += " |";
+        for (auto const n : draw_numbers) { line += std::format(" {:>2}", n); }
+
+        lines.push_back(std::move(line));
+    }
+
+    return lines;
+}
+
+auto AoC2023::generate_day5(std::size_t scale, std::uint64_t seed) -> SolutionInputValue {
+    static constexpr std::array<std::string_view, 7> SECTIONS {
+        "seed-to-soil", "soil-to-fertilizer", "fertilizer-to-water", "water-to-light",
+        "light-to-temperature", "temperature-to-humidity", "humidity-to-location"
+    };
+    static constexpr std::int64_t ID_SPACE = 1ll << 32;
+
+    generator_engine_type engine(seed);
+    SolutionInputValue lines{};
+
+    std::string seeds_line{ "seeds:" };
+    for (std::size_t i = 0; i < 10 * scale; ++i) {
+        seeds_line += std::format(" {} {}", uniform(engine, 0, ID_SPACE - 1), uniform(engine, 1'000'000, 100'000'000));
+    }
+    lines.push_back(std::move(seeds_line));
+
+    for (auto const section : SECTIONS) {
+        lines.emplace_back("");
+        lines.push_back(std::format("{} map:", section));
+
+        // Cut the id space into disjoint source ranges and lay the same lengths
+        // out again in a shuffled order for the destinations
+        std::set<std::int64_t> cuts{};
+        while (cuts.size() < 60 * scale) {
+            cuts.insert(uniform(engine, 0, ID_SPACE));
+        }
+
+        std::vector<std::int64_t> sorted_cuts{ cuts.begin(), cuts.end() };
+        std::vector<std::pair<std::int64_t, std::int64_t>> sources{};
+        for (std::size_t i = 0; i + 1 < sorted_cuts.size(); i += 2) {
+            sources.emplace_back(sorted_cuts.at(i), sorted_cuts.at(i + 1) - sorted_cuts.at(i));
+        }
+
+        std::vector<std::size_t> order(sources.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::shuffle(order.begin(), order.end(), engine);
+
+        std::int64_t destination = uniform(engine, 0, ID_SPACE / 4);
+        for (auto const i : order) {
+            auto const [source, length] = sources.at(i);
+            lines.push_back(std::format("{} {} {}", destination, source, length));
+            destination += length;
+        }
+    }
+
+    return lines;
+}
+
+auto AoC2023::generate_day6(std::size_t scale, std::uint64_t seed) -> SolutionInputValue {
+    generator_engine_type engine(seed);
+    std::string time_line{ "Time:    " };
+    std::string distance_line{ "Distance:" };
+
+    // Part 1 multiplies the win counts of all races, which the reference does
+    // in int. Races are drawn freely while that product still fits, every race
+    // after that gets an even time and a record one short of the best, which
+    // only the hold of half the time beats.
+    std::int64_t product = 1;
+
+    for (std::size_t i = 0; i < 4 * scale; ++i) {
+        auto time = uniform(engine, 7, 99);
+        auto best = (time / 2) * (time - time / 2);
+        auto record = uniform(engine, best / 2, best - 1);
+
+        std::int64_t wins = 0;
+        for (std::int64_t hold = 0; hold <= time; ++hold) {
+            wins += (hold * (time - hold) > record);
+        }
+
+        if (product * wins > std::numeric_limits<int>::max()) {
+            time = 2 * uniform(engine, 4, 49);
+            best = (time / 2) * (time / 2);
+            record = best - 1;
+            wins = 1;
+        }
+
+        product *= wins;
+        time_line += std::format(" {:>4}", time);
+        distance_line += std::format(" {:>4}", record);
+    }
+
+    return { time_line, distance_line };
+}
+
+auto AoC2023::generate_day6_part2(std::size_t scale, std::uint64_t seed) -> SolutionInputValue {
+    // Part 2 reads the table as one race, so it is the magnitude of that race
+    // that grows, one more digit of race time every time the scale doubles.
+    // Times stop at MAX_TIME, where the best distance still fits in 64 bits.
+    static constexpr std::int64_t MAX_TIME = 6'000'000'000;
+
+    generator_engine_type engine(seed);
+    auto const digits = std::min<std::size_t>(10, 2 + std::bit_width(scale));
+
+    std::int64_t low = 1;
+    for (std::size_t i = 1; i < digits; ++i) {
+        low *= 10;
+    }
+
+    auto const time = uniform(engine, std::min(low, MAX_TIME / 10), std::min(low * 10 - 1, MAX_TIME));
+    auto const best = (time / 2) * (time - time / 2);
+    auto const record = uniform(engine, best / 2, best - 1);
+
+    // The race is kerned over one column per digit of its time, so that the
+    // input grows with the number of digits
+    auto const time_digits = std::to_string(time);
+    auto const record_digits = std::to_string(record);
+    auto const columns = time_digits.size();
+    auto const width = record_digits.size() / columns + 2;
+
+    std::string time_line{ "Time:    " };
+    std::string distance_line{ "Distance:" };
+    std::size_t record_offset = 0;
+    for (std::size_t i = 0; i < columns; ++i) {
+        auto const record_width = record_digits.size() / columns + (i < record_digits.size() % columns);
+        time_line += std::format(" {:>{}}", time_digits.at(i), width);
+        distance_line += std::format(" {:>{}}", record_digits.substr(record_offset, record_width), width);
+        record_offset += record_width;
+    }
+
+    return { time_line, distance_line };
+}
+
+auto AoC2023::generate_day7(std::size_t scale, std::uint64_t seed) -> SolutionInputValue {
+    static constexpr std::string_view CARDS { "23456789TJQKA" };
+
+    generator_engine_type engine(seed);
+    SolutionInputValue lines{};
+    lines.reserve(1000 * scale);
+
+    for (std::size_t i = 0; i < 1000 * scale; ++i) {
+        std::string line(5, '\0');
+        for (auto& c : line) {
+            c = CARDS.at(uniform(engine, 0, CARDS.size() - 1));
+        }
+
+        line += std::format(" {}", uniform(engine, 1, 1000));
+        lines.push_back(std::move(line));
+    }
+
+    return lines;
+}
+
+auto AoC2023::generate_day8(std::size_t scale, std::uint64_t seed) -> SolutionInputValue {
+    // Each ghost walks from its start node onto a ring of m * p nodes that ends
+    // in its Z node, where m is the instruction count and p a distinct prime,
+    // which is the structure the real puzzle input has
+    static constexpr std::array<std::int64_t, 6> RING_PRIMES { 3, 5, 7, 11, 13, 17 };
+
+    generator_engine_type engine(seed);
+    auto const instruction_count = static_cast<std::int64_t>(4 * scale);
+
+    std::string instructions{};
+    for (std::int64_t i = 0; i < instruction_count; ++i) {
+        instructions += (uniform(engine, 0, 1) == 0) ? 'L' : 'R';
+    }
+
+    // Ring nodes take every three character name of digits and capitals that
+    // does not end in A or Z, larger scales need more nodes than there are
+    // names
+    static constexpr std::string_view NAME_CHARACTERS { "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ" };
+    auto const ring_nodes = static_cast<std::size_t>(instruction_count * std::reduce(RING_PRIMES.begin(), RING_PRIMES.end()));
+    std::size_t const name_count = NAME_CHARACTERS.size() * NAME_CHARACTERS.size() * (NAME_CHARACTERS.size() - 2);
+    if (ring_nodes > name_count) {
+        throw std::out_of_range(std::format("day 8 generator runs out of node names past scale {}", name_count / (ring_nodes / scale)));
+    }
+
+    std::vector<std::string> names{};
+    names.reserve(name_count);
+    for (char const a : NAME_CHARACTERS) {
+        for (char const b : NAME_CHARACTERS) {
+            for (char const c : NAME_CHARACTERS) {
+                if (c != 'A' && c != 'Z') {
+                    names.push_back(std::string{ a, b, c });
+                }
+            }
+        }
+    }
+    std::shuffle(names.begin(), names.end(), engine);
+
+    auto const ghost_names = unique_numbers(engine, RING_PRIMES.size() - 1, 1, 26 * 26 - 2);
+    auto const ghost_name = [&ghost_names](std::size_t ghost, char suffix) {
+        if (ghost == 0) {
+            return std::string(3, suffix);
+        }
+        auto const id = ghost_names.at(ghost - 1);
+        return std::string{ static_cast<char>('A' + id / 26), static_cast<char>('A' + id % 26), suffix };
+    };
+
+    std::vector<std::string> node_lines{};
+    std::size_t name_index = 0;
+    for (std::size_t ghost = 0; ghost < RING_PRIMES.size(); ++ghost) {
+        auto const ring_length = instruction_count * RING_PRIMES.at(ghost);
+        std::vector<std::string> ring{};
+        for (std::int64_t i = 0; i + 1 < ring_length; ++i) {
+            ring.push_back(names.at(name_index++));
+        }
+        ring.push_back(ghost_name(ghost, 'Z'));
+
+        node_lines.push_back(std::format("{} = ({}, {})", ghost_name(ghost, 'A'), ring.front(), ring.front()));
+        for (std::size_t i = 0; i < ring.size(); ++i) {
+            auto const& next = ring.at((i + 1) % ring.size());
+            node_lines.push_back(std::format("{} = ({}, {})", ring.at(i), next, next));
+        }
+    }
+    std::shuffle(node_lines.begin(), node_lines.end(), engine);
+
+    SolutionInputValue lines{ instructions, "" };
+    std::ranges::move(node_lines, std::back_inserter(lines));
+
+    return lines;
+}
+
+auto AoC2023::generate_day9(std::size_t scale, std::uint64_t seed) -> SolutionInputValue {
+    generator_engine_type engine(seed);
+    SolutionInputValue lines{};
+    lines.reserve(200 * scale);
+
+    for (std::size_t i = 0; i < 200 * scale; ++i) {
+        std::array<std::int64_t, 7> coefficients{};
+        auto const degree = uniform(engine, 1, 6);
+        for (std::int64_t d = 0; d <= degree; ++d) {
+            coefficients.at(d) = uniform(engine, -3, 3);
+        }
+
+        std::string line{};
+        auto const x_start = uniform(engine, -5, 5);
+        for (std::int64_t x = x_start; x < x_start + 21; ++x) {
+            std::int64_t value = 0;
+            for (auto const c : coefficients | std::views::reverse) {
+                value = value * x + c;
+            }
+            line += std::format("{}{}", (line.empty()) ? "" : " ", value);
+        }
+
+        lines.push_back(std::move(line));
+    }
+
+    return lines;
+}
+
+auto AoC2023::generate_day10(std::size_t scale, std::uint64_t seed) -> SolutionInputValue {
+    static constexpr std::string_view JUNK { "|-LJ7F" };
+
+    generator_engine_type engine(seed);
+    auto const size = static_cast<std::int64_t>(std::lround(140.0 * std::sqrt(static_cast<double>(scale))));
+    auto const middle = size / 2;
+
+    // The loop follows a random top edge above the middle row and a random
+    // bottom edge below it, which are joined by the first and last columns
+    std::vector<std::int64_t> top(size);
+    std::vector<std::int64_t> bottom(size);
+    for (std::int64_t j = 1; j < size - 1; ++j) {
+        top.at(j) = uniform(engine, 1, middle - 1);
+        bottom.at(j) = uniform(engine, middle + 1, size - 2);
+    }
+    top.at(2) = top.at(1);
+    bottom.at(2) = bottom.at(1);
+    top.at(size - 3) = top.at(size - 2);
+    bottom.at(size - 3) = bottom.at(size - 2);
+
+    std::vector<std::pair<std::int64_t, std::int64_t>> path{};
+    auto const walk_to = [&path](std::int64_t row, std::int64_t column) {
+        auto [r, c] = path.back();
+        while (r != row || c != column) {
+            if (r != row) {
+                r += (r < row) ? 1 : -1;
+            } else {
+                c += (c < column) ? 1 : -1;
+            }
+            path.emplace_back(r, c);
+        }
+    };
+
+    path.emplace_back(top.at(1), 1);
+    for (std::int64_t j = 2; j < size - 1; ++j) {
+        walk_to(top.at(j - 1), j);
+        walk_to(top.at(j), j);
+    }
+    walk_to(bottom.at(size - 2), size - 2);
+    for (std::int64_t j = size - 3; j >= 1; --j) {
+        walk_to(bottom.at(j + 1), j);
+        walk_to(bottom.at(j), j);
+    }
+    walk_to(top.at(1) + 1, 1);
+
+    SolutionInputValue lines(size, std::string(size, '.'));
+    for (auto& line : lines) {
+        for (auto& c : line) {
+            c = (uniform(engine, 0, 1) == 0) ? '.' : JUNK.at(uniform(engine, 0, JUNK.size() - 1));
+        }
+    }
+
+    auto const pipe_between = [](std::pair<std::int64_t, std::int64_t> from,
+                                 std::pair<std::int64_t, std::int64_t> at,
+                                 std::pair<std::int64_t, std::int64_t> to) {
+        bool north = from.first < at.first || to.first < at.first;
+        bool south = from.first > at.first || to.first > at.first;
+        bool west = from.second < at.second || to.second < at.second;
+        bool east = from.second > at.second || to.second > at.second;
+
+        if (north && south) return '|';
+        if (east && west)   return '-';
+        if (north && east)  return 'L';
+        if (north && west)  return 'J';
+        if (south && west)  return '7';
+        return 'F';
+    };
+
+    for (std::size_t i = 0; i < path.size(); ++i) {
+        auto const& previous = path.at((i + path.size() - 1) % path.size());
+        auto const& next = path.at((i + 1) % path.size());
+        lines.at(path.at(i).first).at(path.at(i).second) = pipe_between(previous, path.at(i), next);
+    }
+
+    // The animal's neighbours must not point back at it unless they are part
+    // of the loop, otherwise its pipe is ambiguous
+    auto const animal = path.at(uniform(engine, 0, path.size() - 1));
+    for (auto const& [di, dj] : std::array<std::pair<std::int64_t, std::int64_t>, 4>{{ {-1, 0}, {1, 0}, {0, -1}, {0, 1} }}) {
+        std::pair<std::int64_t, std::int64_t> const neighbour{ animal.first + di, animal.second + dj };
+        if (std::ranges::find(path, neighbour) == path.end()) {
+            lines.at(neighbour.first).at(neighbour.second) = '.';
+        }
+    }
+    lines.at(animal.first).at(animal.second) = 'S';
+
+    return lines;
+}
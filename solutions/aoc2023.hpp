@@ -1,3 +1,4 @@
+#include <cstdint>
 #include <vector>
 #include <string>
 
@@ -6,35 +7,61 @@
 namespace AoC2023 {
     // Day 1
     auto day1_part1(SolutionInput input) -> SolutionReturn;
+    auto day1_part1_simd(SolutionInput input) -> SolutionReturn;
+    auto day1_part1_buffer(SolutionInput input) -> SolutionReturn;
     auto day1_part2(SolutionInput input) -> SolutionReturn;
+    auto day1_part2_automaton(SolutionInput input) -> SolutionReturn;
 
     // Day 2
     auto day2_part1(SolutionInput input) -> SolutionReturn;
     auto day2_part2(SolutionInput input) -> SolutionReturn;
+    auto day2_part1_columns(SolutionInput input) -> SolutionReturn;
+    auto day2_part2_columns(SolutionInput input) -> SolutionReturn;
+    auto day2_part1_index(SolutionInput input) -> SolutionReturn;
 
     // Day 3
     auto day3_part1(SolutionInput input) -> SolutionReturn;
     auto day3_part2(SolutionInput input) -> SolutionReturn;
+    auto day3_part1_grid(SolutionInput input) -> SolutionReturn;
+    auto day3_part1_labels(SolutionInput input) -> SolutionReturn;
+    auto day3_part2_labels(SolutionInput input) -> SolutionReturn;
+    auto day3_part1_tiled(SolutionInput input) -> SolutionReturn;
+    auto day3_part2_tiled(SolutionInput input) -> SolutionReturn;
 
     // Day 4
     auto day4_part1(SolutionInput input) -> SolutionReturn;
     auto day4_part2(SolutionInput input) -> SolutionReturn;
+    auto day4_part1_bitset(SolutionInput input) -> SolutionReturn;
+    auto day4_part2_bitset(SolutionInput input) -> SolutionReturn;
 
     // Day 5
     auto day5_part1(SolutionInput input) -> SolutionReturn;
     auto day5_part2(SolutionInput input) -> SolutionReturn;
+    auto day5_part1_composed(SolutionInput input) -> SolutionReturn;
+    auto day5_part2_composed(SolutionInput input) -> SolutionReturn;
+    auto day5_part1_lookup(SolutionInput input) -> SolutionReturn;
+    auto day5_part2_reverse(SolutionInput input) -> SolutionReturn;
+    auto day5_part2_parallel(SolutionInput input) -> SolutionReturn;
 
     // Day 6
     auto day6_part1(SolutionInput input) -> SolutionReturn;
     auto day6_part2(SolutionInput input) -> SolutionReturn;
+    auto day6_part1_closed_form(SolutionInput input) -> SolutionReturn;
+    auto day6_part2_closed_form(SolutionInput input) -> SolutionReturn;
 
     // Day 7
     auto day7_part1(SolutionInput input) -> SolutionReturn;
     auto day7_part2(SolutionInput input) -> SolutionReturn;
+    auto day7_part1_radix(SolutionInput input) -> SolutionReturn;
+    auto day7_part2_radix(SolutionInput input) -> SolutionReturn;
+    auto day7_part1_leaderboard(SolutionInput input) -> SolutionReturn;
+    auto day7_part2_leaderboard(SolutionInput input) -> SolutionReturn;
 
     // Day 8
     auto day8_part1(SolutionInput input) -> SolutionReturn;
     auto day8_part2(SolutionInput input) -> SolutionReturn;
+    auto day8_part1_interned(SolutionInput input) -> SolutionReturn;
+    auto day8_part2_cycles(SolutionInput input) -> SolutionReturn;
 
     // Day 9
     auto day9_part1(SolutionInput input) -> SolutionReturn;
@@ -43,4 +70,17 @@ namespace AoC2023 {
     // Day 10
     auto day10_part1(SolutionInput input) -> SolutionReturn;
     auto day10_part2(SolutionInput input) -> SolutionReturn;
+
+    // Input generators, see generators.cpp
+    auto generate_day1(std::size_t scale, std::uint64_t seed) -> SolutionInputValue;
+    auto generate_day2(std::size_t scale, std::uint64_t seed) -> SolutionInputValue;
+    auto generate_day3(std::size_t scale, std::uint64_t seed) -> SolutionInputValue;
+    auto generate_day4(std::size_t scale, std::uint64_t seed) -> SolutionInputValue;
+    auto generate_day5(std::size_t scale, std::uint64_t seed) -> SolutionInputValue;
+    auto generate_day6(std::size_t scale, std::uint64_t seed) -> SolutionInputValue;
+    auto generate_day6_part2(std::size_t scale, std::uint64_t seed) -> SolutionInputValue;
+    auto generate_day7(std::size_t scale, std::uint64_t seed) -> SolutionInputValue;
+    auto generate_day8(std::size_t scale, std::uint64_t seed) -> SolutionInputValue;
+    auto generate_day9(std::size_t scale, std::uint64_t seed) -> SolutionInputValue;
+    auto generate_day10(std::size_t scale, std::uint64_t seed) -> SolutionInputValue;
 } // END of namespace AoC2023
@@ -1,9 +1,13 @@
+#include <algorithm>
 #include <format>
 #include <exception>
+#include <stdexcept>
 #include <fmt/core.h>
 #include <argparse/argparse.hpp>
 
 #include "aocprogram.hpp"
+#include "benchmark.hpp"
+#include "differential.hpp"
 #include "solution.hpp"
 
 auto main(int argc, char** argv) -> int {
@@ -29,6 +33,29 @@ auto main(int argc, char** argv) -> int {
         .default_value("main")
         .help("which data set of AoC to use");
 
+    program.add_argument("--engine")
+        .help("run a registered alternative engine instead of the reference solution");
+
+    program.add_argument("--scaling")
+        .default_value(false)
+        .implicit_value(true)
+        .help("time solutions on generated inputs of growing size and fit their growth exponents");
+
+    program.add_argument("--differential")
+        .default_value(false)
+        .implicit_value(true)
+        .help("check every registered alternative engine against its reference solution");
+
+    program.add_argument("--cases")
+        .default_value<int>(100)
+        .help("number of generated inputs used by --differential")
+        .scan<'i', int>();
+
+    program.add_argument("--max-scale")
+        .default_value<int>(64)
+        .help("largest input scale used by --scaling")
+        .scan<'i', int>();
+
     try {
         program.parse_args(argc, argv);
 
@@ -37,10 +64,47 @@ auto main(int argc, char** argv) -> int {
             return 0;
         }
 
-        if (program.get<int>("year") == -1 &&
-            program.get<int>("day") == -1 &&
-            program.get<int>("part") == -1)
-        {
+        bool const run_all = program.get<int>("year") == -1 &&
+                             program.get<int>("day") == -1 &&
+                             program.get<int>("part") == -1;
+
+        auto const selected = [&program, run_all](std::string_view id) {
+            return run_all || id == std::format("{}:day{}:part{}",
+                                                program.get<int>("year"),
+                                                program.get<int>("day"),
+                                                program.get<int>("part"));
+        };
+
+        if (program.get<bool>("--scaling")) {
+            bench::ScalingOptions options{};
+            options.max_scale = program.get<int>("--max-scale");
+
+            for (auto const& [id, solution] : AocProgram::solutions) {
+                if (selected(id)) {
+                    bench::print_scaling_report(bench::measure_scaling(id, solution, options));
+                }
+            }
+
+            return 0;
+        }
+
+        if (program.get<bool>("--differential")) {
+            differential::DifferentialOptions options{};
+            options.generated_cases = program.get<int>("--cases");
+            std::size_t mismatches = 0;
+
+            for (auto const& [id, engine] : AocProgram::engines) {
+                if (selected(id)) {
+                    auto const report = differential::compare(id, AocProgram::solutions.at(id), engine, options);
+                    differential::print_report(report);
+                    mismatches += report.mismatches;
+                }
+            }
+
+            return (mismatches == 0) ? 0 : 1;
+        }
+
+        if (run_all) {
             for (auto const& [id, solution] : AocProgram::solutions) {
                 auto solution_result = solution("main");
                 fmt::print("{} Day {}, Part {}: {}\n", solution.year(), solution.day(), solution.part(), solution_result.value());
@@ -56,6 +120,27 @@ auto main(int argc, char** argv) -> int {
 
         std::string const data = program.get("data");
 
+        if (program.is_used("--engine")) {
+            std::string const engine_name = program.get("--engine");
+            auto const [first, last] = AocProgram::engines.equal_range(aoc_id);
+            auto const engine = std::find_if(first, last, [&engine_name](auto const& entry) {
+                return entry.second.name == engine_name;
+            });
+
+            if (engine == last) {
+                throw std::invalid_argument(std::format("no engine named {} registered for {}", engine_name, aoc_id));
+            }
+
+            auto const input = AocProgram::solutions.at(aoc_id).input(data);
+            fmt::print("{} Day {}, Part {} [{}]: {}\n",
+                       AocProgram::solutions.at(aoc_id).year(),
+                       AocProgram::solutions.at(aoc_id).day(),
+                       AocProgram::solutions.at(aoc_id).part(),
+                       engine->second.name,
+                       engine->second.function(input.value()));
+            return 0;
+        }
+
         auto solution_result = AocProgram::solutions.at(aoc_id)(data);
         fmt::print("{} Day {}, Part {}: {}\n",
                    AocProgram::solutions.at(aoc_id).year(),
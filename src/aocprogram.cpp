@@ -7,33 +7,69 @@
 #include "aoc2023.hpp"
 
 const std::map<std::string_view, Solution> AocProgram::solutions {
-    { "2023:day1:part1", Solution(2023, 1, 1, &AoC2023::day1_part1, AOC2023_DAY1_INPUTS_INITIALIZER, &parsing::parse_lines) },
-    { "2023:day1:part2", Solution(2023, 1, 2, &AoC2023::day1_part2, AOC2023_DAY1_INPUTS_INITIALIZER, &parsing::parse_lines) },
+    { "2023:day1:part1", Solution(2023, 1, 1, &AoC2023::day1_part1, AOC2023_DAY1_INPUTS_INITIALIZER, &parsing::parse_lines, &AoC2023::generate_day1) },
+    { "2023:day1:part2", Solution(2023, 1, 2, &AoC2023::day1_part2, AOC2023_DAY1_INPUTS_INITIALIZER, &parsing::parse_lines, &AoC2023::generate_day1) },
     
-    { "2023:day2:part1", Solution(2023, 2, 1, &AoC2023::day2_part1, AOC2023_DAY2_INPUTS_INITIALIZER, &parsing::parse_lines) },
-    { "2023:day2:part2", Solution(2023, 2, 2, &AoC2023::day2_part2, AOC2023_DAY2_INPUTS_INITIALIZER, &parsing::parse_lines) },
+    { "2023:day2:part1", Solution(2023, 2, 1, &AoC2023::day2_part1, AOC2023_DAY2_INPUTS_INITIALIZER, &parsing::parse_lines, &AoC2023::generate_day2) },
+    { "2023:day2:part2", Solution(2023, 2, 2, &AoC2023::day2_part2, AOC2023_DAY2_INPUTS_INITIALIZER, &parsing::parse_lines, &AoC2023::generate_day2) },
 
-    { "2023:day3:part1", Solution(2023, 3, 1, &AoC2023::day3_part1, AOC2023_DAY3_INPUTS_INITIALIZER, &parsing::parse_lines) },
-    { "2023:day3:part2", Solution(2023, 3, 2, &AoC2023::day3_part2, AOC2023_DAY3_INPUTS_INITIALIZER, &parsing::parse_lines) },
+    { "2023:day3:part1", Solution(2023, 3, 1, &AoC2023::day3_part1, AOC2023_DAY3_INPUTS_INITIALIZER, &parsing::parse_lines, &AoC2023::generate_day3) },
+    { "2023:day3:part2", Solution(2023, 3, 2, &AoC2023::day3_part2, AOC2023_DAY3_INPUTS_INITIALIZER, &parsing::parse_lines, &AoC2023::generate_day3) },
 
-    { "2023:day4:part1", Solution(2023, 4, 1, &AoC2023::day4_part1, AOC2023_DAY4_INPUTS_INITIALIZER, &parsing::parse_lines) },
-    { "2023:day4:part2", Solution(2023, 4, 2, &AoC2023::day4_part2, AOC2023_DAY4_INPUTS_INITIALIZER, &parsing::parse_lines) },
+    { "2023:day4:part1", Solution(2023, 4, 1, &AoC2023::day4_part1, AOC2023_DAY4_INPUTS_INITIALIZER, &parsing::parse_lines, &AoC2023::generate_day4) },
+    { "2023:day4:part2", Solution(2023, 4, 2, &AoC2023::day4_part2, AOC2023_DAY4_INPUTS_INITIALIZER, &parsing::parse_lines, &AoC2023::generate_day4) },
 
-    { "2023:day5:part1", Solution(2023, 5, 1, &AoC2023::day5_part1, AOC2023_DAY5_INPUTS_INITIALIZER, &parsing::parse_lines) },
-    { "2023:day5:part2", Solution(2023, 5, 2, &AoC2023::day5_part2, AOC2023_DAY5_INPUTS_INITIALIZER, &parsing::parse_lines) },
+    { "2023:day5:part1", Solution(2023, 5, 1, &AoC2023::day5_part1, AOC2023_DAY5_INPUTS_INITIALIZER, &parsing::parse_lines, &AoC2023::generate_day5) },
+    { "2023:day5:part2", Solution(2023, 5, 2, &AoC2023::day5_part2, AOC2023_DAY5_INPUTS_INITIALIZER, &parsing::parse_lines, &AoC2023::generate_day5) },
 
-    { "2023:day6:part1", Solution(2023, 6, 1, &AoC2023::day6_part1, AOC2023_DAY6_INPUTS_INITIALIZER, &parsing::parse_lines) },
-    { "2023:day6:part2", Solution(2023, 6, 2, &AoC2023::day6_part2, AOC2023_DAY6_INPUTS_INITIALIZER, &parsing::parse_lines) },
+    { "2023:day6:part1", Solution(2023, 6, 1, &AoC2023::day6_part1, AOC2023_DAY6_INPUTS_INITIALIZER, &parsing::parse_lines, &AoC2023::generate_day6) },
+    { "2023:day6:part2", Solution(2023, 6, 2, &AoC2023::day6_part2, AOC2023_DAY6_INPUTS_INITIALIZER, &parsing::parse_lines, &AoC2023::generate_day6_part2) },
 
-    { "2023:day7:part1", Solution(2023, 7, 1, &AoC2023::day7_part1, AOC2023_DAY7_INPUTS_INITIALIZER, &parsing::parse_lines) },
-    { "2023:day7:part2", Solution(2023, 7, 2, &AoC2023::day7_part2, AOC2023_DAY7_INPUTS_INITIALIZER, &parsing::parse_lines) },
+    { "2023:day7:part1", Solution(2023, 7, 1, &AoC2023::day7_part1, AOC2023_DAY7_INPUTS_INITIALIZER, &parsing::parse_lines, &AoC2023::generate_day7) },
+    { "2023:day7:part2", Solution(2023, 7, 2, &AoC2023::day7_part2, AOC2023_DAY7_INPUTS_INITIALIZER, &parsing::parse_lines, &AoC2023::generate_day7) },
 
-    { "2023:day8:part1", Solution(2023, 8, 1, &AoC2023::day8_part1, AOC2023_DAY8_INPUTS_INITIALIZER, &parsing::parse_lines) },
-    { "2023:day8:part2", Solution(2023, 8, 2, &AoC2023::day8_part2, AOC2023_DAY8_INPUTS_INITIALIZER, &parsing::parse_lines) },
+    { "2023:day8:part1", Solution(2023, 8, 1, &AoC2023::day8_part1, AOC2023_DAY8_INPUTS_INITIALIZER, &parsing::parse_lines, &AoC2023::generate_day8) },
+    { "2023:day8:part2", Solution(2023, 8, 2, &AoC2023::day8_part2, AOC2023_DAY8_INPUTS_INITIALIZER, &parsing::parse_lines, &AoC2023::generate_day8) },
 
-    { "2023:day9:part1", Solution(2023, 9, 1, &AoC2023::day9_part1, AOC2023_DAY9_INPUTS_INITIALIZER, &parsing::parse_lines) },
-    { "2023:day9:part2", Solution(2023, 9, 2, &AoC2023::day9_part2, AOC2023_DAY9_INPUTS_INITIALIZER, &parsing::parse_lines) },
+    { "2023:day9:part1", Solution(2023, 9, 1, &AoC2023::day9_part1, AOC2023_DAY9_INPUTS_INITIALIZER, &parsing::parse_lines, &AoC2023::generate_day9) },
+    { "2023:day9:part2", Solution(2023, 9, 2, &AoC2023::day9_part2, AOC2023_DAY9_INPUTS_INITIALIZER, &parsing::parse_lines, &AoC2023::generate_day9) },
 
-    { "2023:day10:part1", Solution(2023, 10, 1, &AoC2023::day10_part1, AOC2023_DAY10_INPUTS_INITIALIZER, &parsing::parse_lines) },
-    { "2023:day10:part2", Solution(2023, 10, 2, &AoC2023::day10_part2, AOC2023_DAY10_INPUTS_INITIALIZER, &parsing::parse_lines) }
+    { "2023:day10:part1", Solution(2023, 10, 1, &AoC2023::day10_part1, AOC2023_DAY10_INPUTS_INITIALIZER, &parsing::parse_lines, &AoC2023::generate_day10) },
+    { "2023:day10:part2", Solution(2023, 10, 2, &AoC2023::day10_part2, AOC2023_DAY10_INPUTS_INITIALIZER, &parsing::parse_lines, &AoC2023::generate_day10) }
+};
+
+const std::multimap<std::string_view, SolutionEngine> AocProgram::engines {
+    { "2023:day1:part1", SolutionEngine{ "simd", &AoC2023::day1_part1_simd } },
+    { "2023:day1:part1", SolutionEngine{ "buffer", &AoC2023::day1_part1_buffer } },
+    { "2023:day1:part2", SolutionEngine{ "automaton", &AoC2023::day1_part2_automaton } },
+
+    { "2023:day2:part1", SolutionEngine{ "columns", &AoC2023::day2_part1_columns } },
+    { "2023:day2:part1", SolutionEngine{ "index", &AoC2023::day2_part1_index } },
+    { "2023:day2:part2", SolutionEngine{ "columns", &AoC2023::day2_part2_columns } },
+
+    { "2023:day3:part1", SolutionEngine{ "grid", &AoC2023::day3_part1_grid } },
+    { "2023:day3:part1", SolutionEngine{ "labels", &AoC2023::day3_part1_labels } },
+    { "2023:day3:part1", SolutionEngine{ "tiled", &AoC2023::day3_part1_tiled } },
+    { "2023:day3:part2", SolutionEngine{ "labels", &AoC2023::day3_part2_labels } },
+    { "2023:day3:part2", SolutionEngine{ "tiled", &AoC2023::day3_part2_tiled } },
+
+    { "2023:day4:part1", SolutionEngine{ "bitset", &AoC2023::day4_part1_bitset } },
+    { "2023:day4:part2", SolutionEngine{ "bitset", &AoC2023::day4_part2_bitset } },
+
+    { "2023:day5:part1", SolutionEngine{ "composed", &AoC2023::day5_part1_composed } },
+    { "2023:day5:part1", SolutionEngine{ "lookup", &AoC2023::day5_part1_lookup } },
+    { "2023:day5:part2", SolutionEngine{ "composed", &AoC2023::day5_part2_composed } },
+    { "2023:day5:part2", SolutionEngine{ "reverse", &AoC2023::day5_part2_reverse } },
+    { "2023:day5:part2", SolutionEngine{ "parallel", &AoC2023::day5_part2_parallel } },
+
+    { "2023:day6:part1", SolutionEngine{ "closed_form", &AoC2023::day6_part1_closed_form } },
+    { "2023:day6:part2", SolutionEngine{ "closed_form", &AoC2023::day6_part2_closed_form } },
+
+    { "2023:day7:part1", SolutionEngine{ "radix", &AoC2023::day7_part1_radix } },
+    { "2023:day7:part1", SolutionEngine{ "leaderboard", &AoC2023::day7_part1_leaderboard } },
+    { "2023:day7:part2", SolutionEngine{ "radix", &AoC2023::day7_part2_radix } },
+    { "2023:day7:part2", SolutionEngine{ "leaderboard", &AoC2023::day7_part2_leaderboard } },
+
+    { "2023:day8:part1", SolutionEngine{ "interned", &AoC2023::day8_part1_interned } },
+    { "2023:day8:part2", SolutionEngine{ "cycles", &AoC2023::day8_part2_cycles } }
 };
@@ -7,6 +7,7 @@
 class AocProgram {
 public:
     static const std::map<std::string_view, Solution> solutions;
+    static const std::multimap<std::string_view, SolutionEngine> engines;
 
 private:
 };
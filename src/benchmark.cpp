@@ -0,0 +1,190 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <exception>
+#include <numeric>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include <fmt/core.h>
+
+#include "benchmark.hpp"
+#include "memory.hpp"
+#include "solution.hpp"
+
+static constexpr double MINIMUM_BATCH_SECONDS = 0.01;
+
+auto bench::ScalingReport::super_linear() const -> bool {
+    return this->time_exponent.value_or(0.0) > SUPER_LINEAR_EXPONENT
+        || this->memory_exponent.value_or(0.0) > SUPER_LINEAR_EXPONENT;
+}
+
+auto bench::input_bytes(SolutionInput input) -> std::size_t {
+    return std::accumulate(input.begin(), input.end(), 0uz,
+                           [](std::size_t acc, auto const& line) { return acc + line.size() + 1; });
+}
+
+// Least squares slope of log(y) against log(x)
+auto bench::fit_exponent(std::span<std::pair<double, double> const> points) -> std::optional<double> {
+    std::vector<std::pair<double, double>> log_points{};
+    for (auto const& [x, y] : points) {
+        if (x > 0.0 && y > 0.0) {
+            log_points.emplace_back(std::log(x), std::log(y));
+        }
+    }
+
+    if (log_points.size() < 2) {
+        return std::nullopt;
+    }
+
+    double const n = log_points.size();
+    double mean_x = 0.0;
+    double mean_y = 0.0;
+    for (auto const& [x, y] : log_points) {
+        mean_x += x / n;
+        mean_y += y / n;
+    }
+
+    double covariance = 0.0;
+    double variance = 0.0;
+    for (auto const& [x, y] : log_points) {
+        covariance += (x - mean_x) * (y - mean_y);
+        variance += (x - mean_x) * (x - mean_x);
+    }
+
+    if (variance == 0.0) {
+        return std::nullopt;
+    }
+
+    return covariance / variance;
+}
+
+// Time of one run on an input of `bytes` bytes, extrapolated from the last
+// sample with the exponent fitted so far, or linearly from a single sample
+static auto predict_seconds(std::span<bench::ScalingSample const> samples, std::size_t bytes) -> double {
+    if (samples.empty()) {
+        return 0.0;
+    }
+
+    std::vector<std::pair<double, double>> time_points{};
+    for (auto const& sample : samples) {
+        time_points.emplace_back(sample.input_bytes, sample.seconds);
+    }
+
+    auto const exponent = std::max(1.0, bench::fit_exponent(time_points).value_or(1.0));
+    auto const& last = samples.back();
+    if (last.input_bytes == 0) {
+        return last.seconds;
+    }
+
+    return last.seconds * std::pow(static_cast<double>(bytes) / last.input_bytes, exponent);
+}
+
+auto bench::measure_scaling(std::string_view id, Solution const& solution, ScalingOptions const& options) -> ScalingReport {
+    ScalingReport report{ std::string{id}, {}, std::nullopt, std::nullopt, std::nullopt };
+
+    for (std::size_t scale = 1; scale <= options.max_scale; scale *= 2) {
+        std::optional<SolutionInputValue> input{};
+        try {
+            input = solution.generate(scale, options.seed);
+        }
+
+        catch (std::exception const& error) {
+            report.stopped = fmt::format("scale {} could not be generated: {}", scale, error.what());
+            break;
+        }
+
+        if (!input) {
+            report.stopped = "no input generator";
+            break;
+        }
+
+        // Runs are only checked against the budget once they finish, so a
+        // scale that the samples so far say would overrun it is not started
+        if (auto const predicted = predict_seconds(report.samples, bench::input_bytes(*input)); predicted > options.time_budget) {
+            report.stopped = fmt::format("scale {} would take about {:.1f}s, over the {}s time budget", scale, predicted, options.time_budget);
+            break;
+        }
+
+        std::vector<double> timings{};
+        std::size_t peak_bytes = 0;
+
+        try {
+            for (std::size_t i = 0; i < std::max(1uz, options.repeat); ++i) {
+                auto const baseline_bytes = memory::current_bytes();
+                memory::reset_peak();
+
+                // Fast solutions are run in a batch so that timer resolution
+                // does not dominate the fit
+                std::size_t runs = 0;
+                auto const start = std::chrono::steady_clock::now();
+                std::chrono::duration<double> elapsed{};
+                do {
+                    [[maybe_unused]] volatile auto result = solution.run(*input);
+                    elapsed = std::chrono::steady_clock::now() - start;
+                    ++runs;
+                } while (elapsed.count() < MINIMUM_BATCH_SECONDS);
+
+                timings.push_back(elapsed.count() / runs);
+                peak_bytes = std::max(peak_bytes, memory::peak_bytes() - baseline_bytes);
+
+                if (elapsed.count() > options.time_budget) {
+                    break;
+                }
+            }
+        }
+
+        catch (std::exception const& error) {
+            report.stopped = fmt::format("scale {} threw: {}", scale, error.what());
+            break;
+        }
+
+        std::ranges::sort(timings);
+        report.samples.emplace_back(scale, bench::input_bytes(*input), timings.at(timings.size() / 2), peak_bytes);
+
+        if (timings.back() > options.time_budget) {
+            report.stopped = fmt::format("scale {} exceeded the {}s time budget", scale, options.time_budget);
+            break;
+        }
+    }
+
+    std::vector<std::pair<double, double>> time_points{};
+    std::vector<std::pair<double, double>> memory_points{};
+    for (auto const& sample : report.samples) {
+        time_points.emplace_back(sample.input_bytes, sample.seconds);
+        memory_points.emplace_back(sample.input_bytes, sample.peak_bytes);
+    }
+
+    report.time_exponent = bench::fit_exponent(time_points);
+    report.memory_exponent = bench::fit_exponent(memory_points);
+
+    return report;
+}
+
+auto bench::print_scaling_report(ScalingReport const& report) -> void {
+    auto const exponent = [](std::optional<double> value) {
+        return (value) ? fmt::format("n^{:.2f}", *value) : std::string{"n/a"};
+    };
+
+    fmt::print("{}\n", report.id);
+    fmt::print("    {:>6} {:>14} {:>14} {:>14}\n", "scale", "input bytes", "time (ms)", "peak heap");
+    for (auto const& sample : report.samples) {
+        fmt::print("    {:>6} {:>14} {:>14.3f} {:>14}\n",
+                   sample.scale,
+                   sample.input_bytes,
+                   sample.seconds * 1000.0,
+                   sample.peak_bytes);
+    }
+
+    if (report.stopped) {
+        fmt::print("    stopped: {}\n", *report.stopped);
+    }
+
+    fmt::print("    time ~ {}, memory ~ {}{}\n",
+               exponent(report.time_exponent),
+               exponent(report.memory_exponent),
+               (report.super_linear()) ? "  [SUPER-LINEAR]" : "");
+}
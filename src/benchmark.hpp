@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "solution.hpp"
+
+namespace bench {
+    // Growth exponents above this are reported as super-linear
+    static constexpr double SUPER_LINEAR_EXPONENT = 1.25;
+
+    struct ScalingOptions {
+        std::size_t max_scale = 64;
+        std::size_t repeat = 3;
+        double time_budget = 10.0;
+        std::uint64_t seed = 2023;
+    };
+
+    struct ScalingSample {
+        std::size_t scale;
+        std::size_t input_bytes;
+        double seconds;
+        std::size_t peak_bytes;
+    };
+
+    struct ScalingReport {
+        std::string id;
+        std::vector<ScalingSample> samples;
+        std::optional<std::string> stopped;
+        std::optional<double> time_exponent;
+        std::optional<double> memory_exponent;
+
+        auto super_linear() const -> bool;
+    };
+
+    auto input_bytes(SolutionInput input) -> std::size_t;
+    auto fit_exponent(std::span<std::pair<double, double> const> points) -> std::optional<double>;
+    auto measure_scaling(std::string_view id, Solution const& solution, ScalingOptions const& options) -> ScalingReport;
+    auto print_scaling_report(ScalingReport const& report) -> void;
+} // END of namespace bench
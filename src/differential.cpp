@@ -0,0 +1,199 @@
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <functional>
+#include <optional>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include <fmt/core.h>
+
+#include "differential.hpp"
+#include "solution.hpp"
+
+static constexpr std::size_t MAX_PRINTED_LINES = 40;
+
+struct TimedResult {
+    std::optional<SolutionReturn> value;
+    std::optional<std::string> error;
+    double seconds;
+};
+
+static auto timed_run(std::function<SolutionReturn(SolutionInput)> const& function, SolutionInput input) -> TimedResult {
+    auto const start = std::chrono::steady_clock::now();
+    TimedResult result{ std::nullopt, std::nullopt, 0.0 };
+
+    try {
+        result.value = function(input);
+    }
+
+    catch (std::exception const& error) {
+        result.error = error.what();
+    }
+
+    catch (...) {
+        result.error = "unknown exception";
+    }
+
+    std::chrono::duration<double> const elapsed = std::chrono::steady_clock::now() - start;
+    result.seconds = elapsed.count();
+
+    return result;
+}
+
+auto differential::DifferentialReport::speedup() const -> double {
+    return (this->engine_seconds > 0.0) ? this->reference_seconds / this->engine_seconds : 0.0;
+}
+
+auto differential::minimize(SolutionInputValue input, std::function<bool(SolutionInput)> const& fails) -> SolutionInputValue {
+    std::size_t chunk = std::max(1uz, input.size() / 2);
+
+    while (chunk >= 1 && input.size() > 1) {
+        bool removed = false;
+
+        for (std::size_t start = 0; start < input.size() && input.size() > 1;) {
+            SolutionInputValue candidate{};
+            candidate.reserve(input.size());
+            for (std::size_t i = 0; i < input.size(); ++i) {
+                if (i < start || i >= start + chunk) {
+                    candidate.push_back(input[i]);
+                }
+            }
+
+            if (!candidate.empty() && fails(candidate)) {
+                input = std::move(candidate);
+                removed = true;
+            } else {
+                start += chunk;
+            }
+        }
+
+        if (!removed) {
+            chunk /= 2;
+        }
+    }
+
+    return input;
+}
+
+auto differential::compare(std::string_view id,
+                           Solution const& reference,
+                           SolutionEngine const& engine,
+                           DifferentialOptions const& options) -> DifferentialReport {
+    DifferentialReport report{};
+    report.id = std::string{id};
+    report.engine = std::string{engine.name};
+
+    // A generated input only counts when the reference accepts it, the engine
+    // then has to agree with it exactly. The puzzle inputs are real, so there a
+    // reference that throws while the engine answers is a mismatch as well.
+    auto const reference_function = [&reference](SolutionInput input) { return reference.run(input); };
+    auto const fails = [&](SolutionInput input) {
+        auto const expected = timed_run(reference_function, input);
+        if (!expected.value) {
+            return false;
+        }
+
+        auto const actual = timed_run(engine.function, input);
+        return actual.value != expected.value;
+    };
+
+    auto const check = [&](std::string const& label, SolutionInputValue const& input, bool puzzle_input) {
+        auto const expected = timed_run(reference_function, input);
+        if (!expected.value && !puzzle_input) {
+            ++report.skipped;
+            return;
+        }
+
+        auto const actual = timed_run(engine.function, input);
+        if (!expected.value) {
+            if (!actual.value) {
+                ++report.skipped;
+                return;
+            }
+
+            ++report.cases;
+            ++report.mismatches;
+            if (!report.first_mismatch) {
+                report.first_mismatch = Mismatch{ label, input, std::nullopt, expected.error, actual.value, actual.error };
+            }
+            return;
+        }
+
+        ++report.cases;
+        report.reference_seconds += expected.seconds;
+        report.engine_seconds += actual.seconds;
+
+        if (actual.value != expected.value) {
+            ++report.mismatches;
+            if (!report.first_mismatch) {
+                auto minimized = differential::minimize(input, fails);
+                auto const minimized_expected = timed_run(reference_function, minimized);
+                auto const minimized_actual = timed_run(engine.function, minimized);
+
+                report.first_mismatch = Mismatch{
+                    label,
+                    std::move(minimized),
+                    minimized_expected.value,
+                    minimized_expected.error,
+                    minimized_actual.value,
+                    minimized_actual.error
+                };
+            }
+        }
+    };
+
+    for (auto const selection : reference.input_selections()) {
+        if (auto const input = reference.input(selection)) {
+            check(std::string{selection}, *input, true);
+        }
+    }
+
+    for (std::size_t i = 0; i < options.generated_cases; ++i) {
+        auto const seed = options.seed + i;
+        if (auto const input = reference.generate(1, seed)) {
+            check(fmt::format("generated (seed {})", seed), *input, false);
+        }
+    }
+
+    return report;
+}
+
+auto differential::print_report(DifferentialReport const& report) -> void {
+    fmt::print("{} [{}]: {} cases, {} skipped, {} mismatches, {:.2f}x speedup ({:.3f}ms reference, {:.3f}ms engine)\n",
+               report.id,
+               report.engine,
+               report.cases,
+               report.skipped,
+               report.mismatches,
+               report.speedup(),
+               report.reference_seconds * 1000.0,
+               report.engine_seconds * 1000.0);
+
+    if (!report.first_mismatch) {
+        return;
+    }
+
+    auto const& mismatch = *report.first_mismatch;
+    fmt::print("    first mismatch on {}, minimized to {} lines\n", mismatch.input_label, mismatch.input.size());
+    if (mismatch.expected) {
+        fmt::print("    expected: {}\n", *mismatch.expected);
+    } else {
+        fmt::print("    expected: threw {}\n", mismatch.expected_error.value_or("unknown exception"));
+    }
+    if (mismatch.actual) {
+        fmt::print("    actual:   {}\n", *mismatch.actual);
+    } else {
+        fmt::print("    actual:   threw {}\n", mismatch.error.value_or("unknown exception"));
+    }
+
+    for (auto const& line : mismatch.input | std::views::take(MAX_PRINTED_LINES)) {
+        fmt::print("    | {}\n", line);
+    }
+
+    if (mismatch.input.size() > MAX_PRINTED_LINES) {
+        fmt::print("    | ... {} more lines\n", mismatch.input.size() - MAX_PRINTED_LINES);
+    }
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "solution.hpp"
+
+namespace differential {
+    struct DifferentialOptions {
+        std::size_t generated_cases = 100;
+        std::uint64_t seed = 2023;
+    };
+
+    struct Mismatch {
+        std::string input_label;
+        SolutionInputValue input;
+        std::optional<SolutionReturn> expected;
+        std::optional<std::string> expected_error;
+        std::optional<SolutionReturn> actual;
+        std::optional<std::string> error;
+    };
+
+    struct DifferentialReport {
+        std::string id;
+        std::string engine;
+        std::size_t cases = 0;
+        std::size_t skipped = 0;
+        std::size_t mismatches = 0;
+        std::optional<Mismatch> first_mismatch;
+        double reference_seconds = 0.0;
+        double engine_seconds = 0.0;
+
+        auto speedup() const -> double;
+    };
+
+    // Drops chunks of lines for as long as the input keeps failing
+    auto minimize(SolutionInputValue input, std::function<bool(SolutionInput)> const& fails) -> SolutionInputValue;
+
+    auto compare(std::string_view id,
+                 Solution const& reference,
+                 SolutionEngine const& engine,
+                 DifferentialOptions const& options) -> DifferentialReport;
+
+    auto print_report(DifferentialReport const& report) -> void;
+} // END of namespace differential
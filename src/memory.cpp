@@ -0,0 +1,49 @@
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <malloc.h>
+
+#include "memory.hpp"
+
+static std::atomic<std::size_t> current_allocated{0};
+static std::atomic<std::size_t> peak_allocated{0};
+
+auto memory::current_bytes() -> std::size_t {
+    return current_allocated.load(std::memory_order_relaxed);
+}
+
+auto memory::peak_bytes() -> std::size_t {
+    return peak_allocated.load(std::memory_order_relaxed);
+}
+
+auto memory::reset_peak() -> void {
+    peak_allocated.store(current_allocated.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+auto operator new(std::size_t size) -> void* {
+    void* pointer = std::malloc((size == 0) ? 1 : size);
+    if (pointer == nullptr) {
+        throw std::bad_alloc();
+    }
+
+    auto const allocated = current_allocated.fetch_add(malloc_usable_size(pointer), std::memory_order_relaxed)
+                         + malloc_usable_size(pointer);
+    auto peak = peak_allocated.load(std::memory_order_relaxed);
+    while (allocated > peak && !peak_allocated.compare_exchange_weak(peak, allocated, std::memory_order_relaxed)) {}
+
+    return pointer;
+}
+
+auto operator delete(void* pointer) noexcept -> void {
+    if (pointer == nullptr) {
+        return;
+    }
+
+    current_allocated.fetch_sub(malloc_usable_size(pointer), std::memory_order_relaxed);
+    std::free(pointer);
+}
+
+auto operator delete(void* pointer, std::size_t) noexcept -> void {
+    ::operator delete(pointer);
+}
@@ -0,0 +1,10 @@
+#pragma once
+
+#include <cstddef>
+
+// Heap usage as seen through the replaced global operator new/delete
+namespace memory {
+    auto current_bytes() -> std::size_t;
+    auto peak_bytes() -> std::size_t;
+    auto reset_peak() -> void;
+} // END of namespace memory
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Process wide worker threads shared by the parallel solution engines
+namespace parallel {
+    class ThreadPool {
+    public:
+        explicit ThreadPool(std::size_t worker_count) {
+            for (std::size_t i = 0; i < worker_count; ++i) {
+                this->workers.emplace_back([this](std::stop_token stop) { this->work(stop); });
+            }
+        }
+
+        ~ThreadPool() {
+            for (auto& worker : this->workers) {
+                worker.request_stop();
+            }
+            this->task_ready.notify_all();
+        }
+
+        auto submit(std::function<void()> task) -> void {
+            {
+                std::scoped_lock lock{ this->tasks_mutex };
+                this->tasks.push_back(std::move(task));
+            }
+            this->task_ready.notify_one();
+        }
+
+        auto size() const -> std::size_t {
+            return this->workers.size();
+        }
+
+    private:
+        auto work(std::stop_token stop) -> void {
+            while (true) {
+                std::function<void()> task;
+                {
+                    std::unique_lock lock{ this->tasks_mutex };
+                    if (!this->task_ready.wait(lock, stop, [this] { return !this->tasks.empty(); })) {
+                        return;
+                    }
+                    task = std::move(this->tasks.front());
+                    this->tasks.pop_front();
+                }
+                task();
+            }
+        }
+
+        std::mutex tasks_mutex;
+        std::condition_variable_any task_ready;
+        std::deque<std::function<void()>> tasks;
+        std::vector<std::jthread> workers;
+    };
+
+    inline auto concurrency() -> std::size_t {
+        return std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    // The calling thread always takes part in the work, so the pool holds one
+    // worker less than the hardware offers
+    inline auto pool() -> ThreadPool& {
+        static ThreadPool instance{ concurrency() - 1 };
+        return instance;
+    }
+
+    // Calls fn(i) for every i in [0, count) on the calling thread and up to
+    // max_threads - 1 pool workers, handing out indices one at a time. Returns
+    // once every index is done and rethrows the first exception thrown by fn.
+    // Helpers that only start after all indices are handed out never touch fn,
+    // so nested calls cannot deadlock on a busy pool.
+    template<typename F>
+    auto for_each_index(std::size_t count, F&& fn, std::size_t max_threads = concurrency()) -> void {
+        struct State {
+            std::atomic<std::size_t> next = 0;
+            std::atomic<std::size_t> done = 0;
+            std::mutex error_mutex;
+            std::exception_ptr error;
+        };
+
+        auto const state = std::make_shared<State>();
+        std::function<void(std::size_t)> const task{ std::ref(fn) };
+        auto const run = [state, &task, count] {
+            for (std::size_t i; (i = state->next.fetch_add(1)) < count;) {
+                try {
+                    task(i);
+                } catch (...) {
+                    std::scoped_lock lock{ state->error_mutex };
+                    state->error = (state->error) ? state->error : std::current_exception();
+                }
+
+                if (state->done.fetch_add(1) + 1 == count) {
+                    state->done.notify_all();
+                }
+            }
+        };
+
+        std::size_t const threads = std::min({ std::max<std::size_t>(max_threads, 1), count, pool().size() + 1 });
+        for (std::size_t i = 1; i < threads; ++i) {
+            pool().submit(run);
+        }
+
+        run();
+
+        for (auto done = state->done.load(); done < count; done = state->done.load()) {
+            state->done.wait(done);
+        }
+
+        if (state->error) {
+            std::rethrow_exception(state->error);
+        }
+    }
+} // END of namespace parallel
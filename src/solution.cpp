@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <expected>
 #include <format>
 #include <initializer_list>
@@ -15,13 +16,15 @@ Solution::Solution(int year_id,
                    int part_id,
                    fn_type solution_function,
                    std::initializer_list<std::pair<std::string_view, std::string_view>> solution_inputs,
-                   fn_input_parser_type solution_input_parser)
+                   fn_input_parser_type solution_input_parser,
+                   fn_input_generator_type solution_input_generator)
     : year_id(year_id)
     , day_id(day_id)
     , part_id(part_id)
     , solution(solution_function)
     , inputs({solution_inputs.begin(), solution_inputs.end()})
     , input_parser(solution_input_parser)
+    , input_generator(solution_input_generator)
 {}
 
 auto Solution::operator()(std::string_view input_selection) const -> std::expected<return_type, std::string> {
@@ -48,6 +51,36 @@ auto Solution::operator()(std::string_view input_selection) const -> std::expect
                                        this->part_id));
 }
 
+auto Solution::run(input_type input) const -> return_type {
+    return this->solution(input);
+}
+
+auto Solution::input(std::string_view input_selection) const -> std::optional<input_value_type> {
+    if (!this->inputs.contains(input_selection)) {
+        return std::nullopt;
+    }
+
+    return this->input_parser(this->inputs.at(input_selection));
+}
+
+auto Solution::input_selections() const -> std::vector<std::string_view> {
+    std::vector<std::string_view> selections{};
+    for (auto const& [selection, path] : this->inputs) {
+        selections.push_back(selection);
+    }
+
+    std::ranges::sort(selections);
+    return selections;
+}
+
+auto Solution::generate(std::size_t scale, std::uint64_t seed) const -> std::optional<input_value_type> {
+    if (this->input_generator == nullptr) {
+        return std::nullopt;
+    }
+
+    return this->input_generator(scale, seed);
+}
+
 auto Solution::year() const -> int {
     return this->year_id;
 }
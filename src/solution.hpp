@@ -17,6 +17,7 @@ public:
     using input_type = std::add_const_t<input_value_type>&;
     using fn_type = return_type(*)(input_type);
     using fn_input_parser_type = std::optional<input_value_type>(*)(std::string_view);
+    using fn_input_generator_type = input_value_type(*)(std::size_t, std::uint64_t);
 
     Solution() = delete;
 
@@ -25,9 +26,14 @@ public:
                       int part_id,
                       fn_type solution_function,
                       std::initializer_list<std::pair<std::string_view, std::string_view>> solution_inputs,
-                      fn_input_parser_type solution_input_parser);
+                      fn_input_parser_type solution_input_parser,
+                      fn_input_generator_type solution_input_generator = nullptr);
 
     auto operator()(std::string_view input_selection) const -> std::expected<return_type, std::string>;
+    auto run(input_type input) const -> return_type;
+    auto input(std::string_view input_selection) const -> std::optional<input_value_type>;
+    auto input_selections() const -> std::vector<std::string_view>;
+    auto generate(std::size_t scale, std::uint64_t seed) const -> std::optional<input_value_type>;
 
     auto year() const -> int;
     auto day() const -> int;
@@ -40,6 +46,14 @@ private:
     const fn_type solution;
     const std::unordered_map<std::string_view, std::string_view> inputs;
     const fn_input_parser_type input_parser;
+    const fn_input_generator_type input_generator;
+};
+
+// An alternative implementation of a solution, checked against the solution
+// itself by the differential harness
+struct SolutionEngine {
+    std::string_view name;
+    Solution::fn_type function;
 };
 
 using SolutionInput = typename Solution::input_type;